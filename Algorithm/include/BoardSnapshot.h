@@ -0,0 +1,45 @@
+#pragma once
+
+#include "DistanceField.h"
+#include "UserCommon/CellIndex.h"
+#include "UserCommon/RayBoard.h"
+#include <memory>
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace Algorithm_212788293_212497127
+{
+    // ========================= CLASS: BoardSnapshot =========================
+    // Everything a player knows about the board after a satellite view, indexed for the
+    // tanks' queries. Snapshots are shared read-only: all tanks that ask within one step
+    // get the same one, and the player copies it only when a later view changes it.
+
+    struct BoardSnapshot
+    {
+        UC::GridIndex grid;
+        UC::CellSet friendlyTanks;
+        UC::CellSet enemyTanks;
+        UC::CellSet mines;
+        UC::CellSet walls;
+        UC::CellSet shells;
+        UC::RayBoard rays;
+        std::shared_ptr<const DistanceFieldCache> distanceFields;
+
+        UC::CellSet &cellsOf(UC::RayBoard::Layer layer)
+        {
+            switch (layer)
+            {
+            case UC::RayBoard::Walls:
+                return walls;
+            case UC::RayBoard::Mines:
+                return mines;
+            case UC::RayBoard::Friendly:
+                return friendlyTanks;
+            case UC::RayBoard::Enemy:
+                return enemyTanks;
+            default:
+                return shells;
+            }
+        }
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "UserCommon/CellIndex.h"
+#include "UserCommon/DirectionUtils.h"
+#include <vector>
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace Algorithm_212788293_212497127
+{
+    // ========================= CLASS: DistanceField =========================
+    // Breadth-first distances from a set of source cells over the tank moves: eight
+    // neighbours, wrapping around the board. Once built, the distance to the nearest
+    // source is a table lookup.
+
+    class DistanceField
+    {
+    public:
+        static constexpr int Unreachable = -1;
+
+        // blocked cells are never entered; the sources themselves always belong to the field
+        void build(const UC::GridIndex &grid, const std::vector<int> &sources, const UC::CellSet &blocked);
+
+        int distance(int cell) const { return dist[cell]; }
+        bool reachable(int cell) const { return dist[cell] != Unreachable; }
+
+    private:
+        std::vector<int> dist;
+        std::vector<int> frontier;
+    };
+
+    // ========================= CLASS: DistanceFieldCache =========================
+    // Per-player data derived from the static obstacles (walls and mines) of the latest
+    // satellite snapshot. It is rebuilt only when those obstacles differ from the previous
+    // snapshot, so the tanks of one player share it across updates.
+
+    class DistanceFieldCache
+    {
+    public:
+        void update(const UC::GridIndex &grid, const UC::CellSet &walls, const UC::CellSet &mines);
+
+        const UC::CellSet &getObstacles() const { return obstacles; }
+
+        // whether any move sequence over free cells links a and b; false when either is blocked
+        bool connected(int a, int b) const;
+
+    private:
+        UC::GridIndex grid;
+        UC::CellSet obstacles;
+        // connected component of every free cell, -1 for obstacles
+        std::vector<int> component;
+    };
+}
@@ -8,6 +8,8 @@
 #include <string>
 #include <memory>
 #include "common/BattleInfo.h"
+#include "UserCommon/CellIndex.h"
+#include "BoardSnapshot.h"
 #include "Roles/Role.h"
 
 namespace Algorithm_212788293_212497127 {
@@ -17,35 +19,29 @@ class Role;
 class MyBattleInfo : public BattleInfo
 {
 private:
-    int width, height;
+    // shared by every tank of the player that asks in the same step; only the fields
+    // below it are this tank's own
+    std::shared_ptr<const BoardSnapshot> board;
     int myX, myY;
     std::unique_ptr<Algorithm_212788293_212497127::Role> role;
     bool shouldKeepRole = false;
-    std::set<int> friendlyTanks;
-    std::set<int> enemyTanks;
-    std::set<int> mines;
-    std::set<int> walls;
-    std::set<int> shells;
     std::vector<std::pair<int, int>> path;
     std::vector<ActionRequest> planedActions;
     std::set<std::pair<int, int>> plannedPositions;
 
 public:
-    MyBattleInfo(int width, int height,
-                 const std::set<int> &friendlyTanks,
-                 const std::set<int> &enemyTanks,
-                 const std::set<int> &mines,
-                 const std::set<int> &walls,
-                 const std::set<int> &shells);
+    explicit MyBattleInfo(std::shared_ptr<const BoardSnapshot> board);
 
     int getWidth() const;
     int getHeight() const;
+    const UC::GridIndex &getGrid() const { return board->grid; }
+    const std::shared_ptr<const BoardSnapshot> &getBoard() const { return board; }
 
-    std::set<int> &getFriendlyTanks();
-    std::set<int> &getEnemyTanks();
-    std::set<int> &getMines();
-    std::set<int> &getWalls();
-    std::set<int> &getShells();
+    const UC::CellSet &getFriendlyTanks() const;
+    const UC::CellSet &getEnemyTanks() const;
+    const UC::CellSet &getMines() const;
+    const UC::CellSet &getWalls() const;
+    const UC::CellSet &getShells() const;
 
     void setMyXPosition(int x);
     void setMyYPosition(int y);
@@ -72,8 +68,8 @@ public:
     std::vector<ActionRequest> getPlannedActions() { return planedActions; }
     void setPlannedActions(std::vector<ActionRequest> actions) { planedActions = actions; }
 
-    std::set<std::pair<int, int>> getPlannedPositions() { return plannedPositions; }
-    void setPlannedPositions(std::set<std::pair<int, int>> positions) { plannedPositions = positions; }
+    std::set<std::pair<int, int>> extractPlannedPositions() { return std::move(plannedPositions); }
+    void setPlannedPositions(std::set<std::pair<int, int>> positions) { plannedPositions = std::move(positions); }
 };
 }
 #endif
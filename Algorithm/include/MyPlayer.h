@@ -8,8 +8,12 @@
 #include "Roles/EvasiorRole.h"
 #include "Roles/DefenderRole.h"
 #include "MyBattleInfo.h"
+#include "BoardSnapshot.h"
 #include "MyTankAlgorithm.h"
 #include "UserCommon/DirectionUtils.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include "UserCommon/CellIndex.h"
+#include "UserCommon/RayBoard.h"
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -36,6 +40,7 @@ namespace Algorithm_212788293_212497127
     protected:
         int player_index;
         size_t playerGameWidth, playerGameHeight;
+        UC::GridIndex grid;
         size_t max_steps, num_shells;
         int lastGameStep;
 
@@ -46,6 +51,11 @@ namespace Algorithm_212788293_212497127
         std::unordered_map<int, UC::Direction> tanksDirection;
         std::unordered_map<int, std::string> tankRoles;
         std::vector<std::vector<char>> lastSatellite;
+        // indexes derived from lastSatellite; each view is diffed against it and only the
+        // cells that changed are patched, so the tanks asking in one step share the work
+        std::shared_ptr<BoardSnapshot> board;
+        int selfCell = -1;
+        bool obstaclesChanged = false;
 
     public:
         MyPlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells);
@@ -57,16 +67,15 @@ namespace Algorithm_212788293_212497127
         }
 
     protected:
-        EnemyScanResult assignRole(int tankId, std::pair<int, int> pos, std::set<int> shells, std::set<int> enemyTanks, int numFriendlyTanks);
-        virtual std::unique_ptr<Algorithm_212788293_212497127::Role> createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int numOfFriendlyTanks) = 0;
+        EnemyScanResult assignRole(int tankId, std::pair<int, int> pos, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numFriendlyTanks);
+        virtual std::unique_ptr<Algorithm_212788293_212497127::Role> createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numOfFriendlyTanks) = 0;
 
-        virtual bool shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int numFriendlyTanks) = 0;
-        EnemyScanResult scanVisibleEnemies(int x0, int y0) const;
+        virtual bool shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numFriendlyTanks) = 0;
+        EnemyScanResult scanVisibleEnemies(int x0, int y0, const UC::CellSet &enemyTanks) const;
         int manhattanDistance(int x1, int y1, int x2, int y2) const;
-        bool isClearLine(int x0, int y0, int x1, int y1) const;
         bool isInOpen(int x, int y) const;
         std::set<std::pair<int, int>> getCalculatedPathsSet();
-        bool isInRedZone(int x, int y, std::set<int> shellsPositions, std::set<int> enemies) const;
+        bool isInRedZone(int x, int y, const UC::CellSet &shellsPositions, const UC::CellSet &enemies) const;
         void updateTanksStatus();
         void deleteTankData(int tankId);
         int getTankId(std::pair<int, int> pos);
@@ -75,7 +84,11 @@ namespace Algorithm_212788293_212497127
     private:
         bool gotBattleInfo = false;
         UC::Direction updateTankDirection(int tankId);
-        std::pair<int, int> prepareInfoForBattleInfo(std::set<int> &mines, std::set<int> &walls, std::set<int> &shells, std::set<int> &friendlyTanks, std::set<int> &enemyTanks, SatelliteView &satellite_view);
+        std::vector<char> incomingRow;
+        std::pair<int, int> prepareInfoForBattleInfo(SatelliteView &satellite_view);
+        void applyCell(int x, int y, char object);
+        UC::RayBoard::Layer layerOf(char object) const;
+        BoardSnapshot &editableBoard();
     };
 
     // ------------------------ Player 1 ------------------------
@@ -85,7 +98,7 @@ namespace Algorithm_212788293_212497127
         using MyPlayer::MyPlayer;
         virtual ~Player_212788293_212497127();
 
-        std::unique_ptr<Algorithm_212788293_212497127::Role> createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int numOfFriendlyTanks) override;
-        bool shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int numFriendlyTanks) override;
+        std::unique_ptr<Algorithm_212788293_212497127::Role> createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numOfFriendlyTanks) override;
+        bool shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numFriendlyTanks) override;
     };
 }
\ No newline at end of file
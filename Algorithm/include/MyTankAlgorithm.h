@@ -5,6 +5,7 @@
 #include "common/BattleInfo.h"
 #include "MyPlayer.h"
 #include "Roles/Role.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -28,14 +29,28 @@ namespace Algorithm_212788293_212497127
         // Metadata from BattleInfo
         std::unordered_map<int, std::vector<std::pair<int, int>>> tanksPlannedPaths;
         std::unique_ptr<Role> role;
-        std::set<int> nearbyFriendlies;
-        std::set<int> threats;
-        std::set<int> mines;
-        std::set<int> walls;
-        std::set<int> shells;
+        UC::GridIndex grid;
+        // the player's snapshot of the board, shared with the other tanks
+        std::shared_ptr<const BoardSnapshot> board;
         std::vector<std::vector<char>> lastSatellite;
         std::set<std::pair<int, int>> bannedPositionsForTank;
 
+        // BFS scratch, sized to the grid and reused by every getPath call: a cell counts as
+        // visited when its stamp equals the current search's epoch, so nothing is cleared
+        // between searches
+        std::vector<std::uint32_t> visitedEpoch;
+        std::vector<int> parentCell;
+        std::vector<int> frontier;
+        std::uint32_t searchEpoch = 0;
+        UC::CellSet avoidMask;
+        // the same for the (cell, facing) states of action-cost searches
+        std::vector<std::uint32_t> stateEpoch;
+        std::vector<int> stateCost;
+        std::vector<int> stateParent;
+
+        void beginSearch();
+        std::vector<std::pair<int, int>> getActionPath(int from, int to, const UC::CellSet &avoidCells);
+
         bool movePending;
         int gameWidth;
         int gameHeight;
@@ -55,12 +70,13 @@ namespace Algorithm_212788293_212497127
         double getAngleFromDirections(const std::string &directionStr, const std::string &desiredDir);
 
         // BFS pathfinding
-        std::vector<std::pair<int, int>> getPath(std::pair<int, int> start, std::pair<int, int> target, std::set<std::pair<int, int>> avoidCells);
-        bool isSquareValid(int x, int y, std::set<std::pair<int, int>> cellsToAvoid);
-        std::pair<int, int> findFirstLegalLocationToFlee(std::pair<int, int> from, std::set<std::pair<int, int>> redZone);
+        std::vector<std::pair<int, int>> getPath(std::pair<int, int> start, std::pair<int, int> target, const std::set<std::pair<int, int>> &avoidCells, PathCost cost = PathCost::Steps);
+        std::vector<std::pair<int, int>> getPath(std::pair<int, int> start, std::pair<int, int> target, const UC::CellSet &avoidCells, PathCost cost = PathCost::Steps);
+        bool isSquareValid(int x, int y, const UC::CellSet &cellsToAvoid) const;
+        std::pair<int, int> findFirstLegalLocationToFlee(std::pair<int, int> from, const std::set<std::pair<int, int>> &redZone);
         std::pair<int, int> getTargetForTank();
         std::pair<int, int> moveTank(std::pair<int, int> pos, UC::Direction dir);
-        std::set<std::pair<int, int>> getBannedPositionsForTank() { return bannedPositionsForTank; };
+        const std::set<std::pair<int, int>> &getBannedPositionsForTank() const { return bannedPositionsForTank; };
         std::set<std::pair<int, int>> getShells();
         bool isThreatAhead();
         bool isFriendlyTooClose();
@@ -69,10 +85,10 @@ namespace Algorithm_212788293_212497127
         int getTankId() const { return tankId; };
         void setPlayerId(int id) { playerId = id; };
         int getPlayerId() const { return playerId; };
-        std::set<int> getEnemyTanks() { return threats; };
+        const UC::CellSet &getEnemyTanks() const { return board->enemyTanks; };
         UC::Direction getCurrentDirection() const { return currentDirection; }
         void setCurrentDirection(UC::Direction dir) { currentDirection = dir; }
-        std::set<int> getMines(){return mines;}
+        const UC::CellSet &getMines() const { return board->mines; }
         std::pair<int, int> getCurrentPosition() const { return currentPos; }
         void setCurrentPosition(std::pair<int, int> pos) { currentPos = pos; }
 
@@ -88,6 +104,7 @@ namespace Algorithm_212788293_212497127
         int manhattanDistance(int x1, int y1, int x2, int y2) const;
         int getGameWidth() const { return gameWidth; }
         int getGameHeight() const { return gameHeight; }
+        const UC::GridIndex &getGrid() const { return grid; }
         bool isInOpen(std::pair<int, int> pos) const;
         std::pair<int, int> findNearestFriendlyTank(std::pair<int, int> myPos);
         bool isThreatWithinRange(int range) const;
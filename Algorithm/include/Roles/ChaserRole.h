@@ -19,5 +19,7 @@ namespace Algorithm_212788293_212497127
         {
             return std::make_unique<ChaserRole>(*this);
         }
+        // drives several moves per update, so fewer rotations pay off directly
+        PathCost getPathCost() const override { return PathCost::Actions; }
     };
 }
\ No newline at end of file
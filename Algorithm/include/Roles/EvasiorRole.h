@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Role.h"
+#include "UserCommon/CellIndex.h"
 #include <optional>
 
 namespace Algorithm_212788293_212497127
@@ -20,11 +21,13 @@ namespace Algorithm_212788293_212497127
         {
             return std::make_unique<EvasiorRole>(*this);
         }
+        // drives several moves per update, so fewer rotations pay off directly
+        PathCost getPathCost() const override { return PathCost::Actions; }
         std::vector<ActionRequest> getNextMoves(std::vector<std::pair<int, int>> path, TankAlgorithm_212788293_212497127 &algo);
 
     private:
         void concatenateSets(std::set<std::pair<int, int>> targetSet, std::set<std::pair<int, int>> setToBeAdded);
         std::set<std::pair<int, int>> createRedZone(std::set<std::pair<int, int>> shells, int distFromTarget);
-        std::set<std::pair<int, int>> transformToPairs(std::set<int> toBeTransformed);
+        std::set<std::pair<int, int>> transformToPairs(const UC::CellSet &toBeTransformed, const UC::GridIndex &grid);
     };
 }
\ No newline at end of file
@@ -12,6 +12,14 @@ namespace Algorithm_212788293_212497127
 {
     class TankAlgorithm_212788293_212497127;
 
+    // What getPath minimises: cells stepped through, or the actions needed to drive the
+    // route (a forward move plus the rotations that line the tank up for it)
+    enum class PathCost
+    {
+        Steps,
+        Actions
+    };
+
     class Role
     {
 
@@ -23,6 +31,7 @@ namespace Algorithm_212788293_212497127
 
         virtual std::string getRoleName() const = 0;
         virtual std::unique_ptr<Role> clone() const = 0;
+        virtual PathCost getPathCost() const { return PathCost::Steps; }
 
         ActionRequest getNextAction();
 
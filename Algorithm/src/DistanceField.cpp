@@ -0,0 +1,93 @@
+#include "DistanceField.h"
+
+namespace Algorithm_212788293_212497127
+{
+    namespace
+    {
+        int neighbour(const UC::GridIndex &grid, int cell, UC::Direction dir)
+        {
+            const auto &offset = UC::DirectionsUtils::stringToIntDirection[dir];
+            const int width = grid.getWidth(), height = grid.getHeight();
+            return grid.index((grid.xOf(cell) + offset[0] + width) % width,
+                              (grid.yOf(cell) + offset[1] + height) % height);
+        }
+    }
+
+    // ------------------------ DistanceField ------------------------
+
+    void DistanceField::build(const UC::GridIndex &grid, const std::vector<int> &sources, const UC::CellSet &blocked)
+    {
+        dist.assign(grid.size(), Unreachable);
+        frontier.resize(grid.size());
+
+        size_t head = 0, tail = 0;
+        for (int source : sources)
+        {
+            if (dist[source] == Unreachable)
+            {
+                dist[source] = 0;
+                frontier[tail++] = source;
+            }
+        }
+
+        while (head < tail)
+        {
+            const int current = frontier[head++];
+            for (UC::Direction dir : UC::DirectionsUtils::directions)
+            {
+                const int next = neighbour(grid, current, dir);
+                if (dist[next] == Unreachable && !blocked.contains(next))
+                {
+                    dist[next] = dist[current] + 1;
+                    frontier[tail++] = next;
+                }
+            }
+        }
+    }
+
+    // ------------------------ DistanceFieldCache ------------------------
+
+    void DistanceFieldCache::update(const UC::GridIndex &grid, const UC::CellSet &walls, const UC::CellSet &mines)
+    {
+        UC::CellSet current = walls;
+        current |= mines;
+        if (grid.getWidth() == this->grid.getWidth() && grid.getHeight() == this->grid.getHeight() && current == obstacles)
+            return;
+
+        this->grid = grid;
+        obstacles = std::move(current);
+        component.assign(grid.size(), -1);
+
+        // moves are symmetric, so flooding from each unlabeled free cell finds its component
+        std::vector<int> frontier(grid.size());
+        int label = 0;
+        for (int start = 0; start < grid.size(); ++start)
+        {
+            if (component[start] != -1 || obstacles.contains(start))
+                continue;
+
+            size_t head = 0, tail = 0;
+            frontier[tail++] = start;
+            component[start] = label;
+            while (head < tail)
+            {
+                const int cell = frontier[head++];
+                for (UC::Direction dir : UC::DirectionsUtils::directions)
+                {
+                    const int next = neighbour(grid, cell, dir);
+                    if (component[next] == -1 && !obstacles.contains(next))
+                    {
+                        component[next] = label;
+                        frontier[tail++] = next;
+                    }
+                }
+            }
+            ++label;
+        }
+    }
+
+    bool DistanceFieldCache::connected(int a, int b) const
+    {
+        return component[a] != -1 && component[a] == component[b];
+    }
+}
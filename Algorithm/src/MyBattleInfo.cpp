@@ -1,25 +1,18 @@
 #include "MyBattleInfo.h"
 namespace Algorithm_212788293_212497127 {
-MyBattleInfo::MyBattleInfo(int width, int height,
-                           const std::set<int> &friendlyTanks,
-                           const std::set<int> &enemyTanks,
-                           const std::set<int> &mines,
-                           const std::set<int> &walls,
-                           const std::set<int> &shells)
-    : width(width), height(height), myX(0), myY(0),
-      friendlyTanks(friendlyTanks), enemyTanks(enemyTanks),
-      mines(mines), walls(walls), shells(shells)
+MyBattleInfo::MyBattleInfo(std::shared_ptr<const BoardSnapshot> board)
+    : board(std::move(board)), myX(0), myY(0)
 {
 }
 
-int MyBattleInfo::getWidth() const { return width; }
-int MyBattleInfo::getHeight() const { return height; }
+int MyBattleInfo::getWidth() const { return board->grid.getWidth(); }
+int MyBattleInfo::getHeight() const { return board->grid.getHeight(); }
 
-std::set<int> &MyBattleInfo::getFriendlyTanks() { return friendlyTanks; }
-std::set<int> &MyBattleInfo::getEnemyTanks() { return enemyTanks; }
-std::set<int> &MyBattleInfo::getMines() { return mines; }
-std::set<int> &MyBattleInfo::getWalls() { return walls; }
-std::set<int> &MyBattleInfo::getShells() { return shells; }
+const UC::CellSet &MyBattleInfo::getFriendlyTanks() const { return board->friendlyTanks; }
+const UC::CellSet &MyBattleInfo::getEnemyTanks() const { return board->enemyTanks; }
+const UC::CellSet &MyBattleInfo::getMines() const { return board->mines; }
+const UC::CellSet &MyBattleInfo::getWalls() const { return board->walls; }
+const UC::CellSet &MyBattleInfo::getShells() const { return board->shells; }
 
 void MyBattleInfo::setMyXPosition(int x) { myX = x; }
 void MyBattleInfo::setMyYPosition(int y) { myY = y; }
@@ -47,27 +40,27 @@ const Algorithm_212788293_212497127::Role &MyBattleInfo::getRole() const
 }
 bool MyBattleInfo::isMine(int x, int y) const
 {
-    return mines.count(UC::bijection(x, y)) > 0;
+    return board->mines.contains(board->grid.index(x, y));
 }
 
 bool MyBattleInfo::isWall(int x, int y) const
 {
-    return walls.count(UC::bijection(x, y)) > 0;
+    return board->walls.contains(board->grid.index(x, y));
 }
 
 bool MyBattleInfo::isShell(int x, int y) const
 {
-    return shells.count(UC::bijection(x, y)) > 0;
+    return board->shells.contains(board->grid.index(x, y));
 }
 
 bool MyBattleInfo::isEnemyTank(int x, int y) const
 {
-    return enemyTanks.count(UC::bijection(x, y)) > 0;
+    return board->enemyTanks.contains(board->grid.index(x, y));
 }
 
 bool MyBattleInfo::isFriendlyTank(int x, int y) const
 {
-    return friendlyTanks.count(UC::bijection(x, y)) > 0;
+    return board->friendlyTanks.contains(board->grid.index(x, y));
 }
 
 
@@ -1,4 +1,5 @@
 #include <queue>
+#include <tuple>
 #include <memory>
 #include "MyTankAlgorithm.h"
 #include "Roles/ChaserRole.h"
@@ -6,6 +7,17 @@
 
 namespace Algorithm_212788293_212497127
 {
+    namespace
+    {
+        // Equally near candidates are resolved in the order the former Cantor-paired cell keys
+        // had (by anti-diagonal x + y, then by y), so tanks keep choosing the same targets.
+        bool diagonalBefore(std::pair<int, int> a, std::pair<int, int> b)
+        {
+            const int da = a.first + a.second;
+            const int db = b.first + b.second;
+            return da != db ? da < db : a.second < b.second;
+        }
+    }
 
     REGISTER_TANK_ALGORITHM(TankAlgorithm_212788293_212497127);
 
@@ -24,14 +36,11 @@ namespace Algorithm_212788293_212497127
         if (!myInfo.getShouldKeepRole() || !role)
             setRole(myInfo.extractRole());
 
-        threats = myInfo.getEnemyTanks();
-        nearbyFriendlies = myInfo.getFriendlyTanks();
-        mines = myInfo.getMines();
-        walls = myInfo.getWalls();
-        bannedPositionsForTank = myInfo.getPlannedPositions();
+        board = myInfo.getBoard();
+        bannedPositionsForTank = myInfo.extractPlannedPositions();
         gameWidth = myInfo.getWidth();
         gameHeight = myInfo.getHeight();
-        shells = myInfo.getShells();
+        grid = myInfo.getGrid();
         currentPos = {myInfo.getMyXPosition(), myInfo.getMyYPosition()};
 
         bfsPath = role->prepareActions(*this);
@@ -61,8 +70,8 @@ namespace Algorithm_212788293_212497127
     bool TankAlgorithm_212788293_212497127::isThreatAhead()
     {
         std::pair<int, int> front = move(currentPos, currentDirection);
-        int id = UC::bijection(front.first, front.second);
-        return threats.count(id) > 0;
+        int id = grid.index(front.first, front.second);
+        return board->enemyTanks.contains(id);
     }
 
     bool TankAlgorithm_212788293_212497127::isFriendlyTooClose()
@@ -70,8 +79,8 @@ namespace Algorithm_212788293_212497127
         for (UC::Direction d : UC::DirectionsUtils::directions)
         {
             std::pair<int, int> adj = move(currentPos, d);
-            int id = UC::bijection(adj.first, adj.second);
-            if (nearbyFriendlies.count(id))
+            int id = grid.index(adj.first, adj.second);
+            if (board->friendlyTanks.contains(id))
                 return true;
         }
         return false;
@@ -79,42 +88,37 @@ namespace Algorithm_212788293_212497127
 
     bool TankAlgorithm_212788293_212497127::shouldShoot(UC::Direction currDir, std::pair<int, int> currPos)
     {
-        std::pair<int, int> look = currentPos;
-        for (int i = 1; i < range + 1; ++i)
-        {
-            look = {(currPos.first + UC::DirectionsUtils::stringToIntDirection[currDir][0] * i + gameWidth) % gameWidth,
-                    (currPos.second + UC::DirectionsUtils::stringToIntDirection[currDir][1] * i + gameHeight) % gameHeight};
-            int id = UC::bijection(look.first, look.second);
-            if (nearbyFriendlies.count(id))
-                return false; // don't friendly fire
-            if (threats.count(id) || walls.count(id))
-                return true;
-        }
-        return false;
+        // the ray can wrap around the board, back onto this tank on small maps
+        int friendly = board->rays.firstHit(UC::RayBoard::Friendly, currPos.first, currPos.second, currDir, range);
+        int target = board->rays.firstHit(UC::RayBoard::layerBit(UC::RayBoard::Enemy) | UC::RayBoard::layerBit(UC::RayBoard::Walls),
+                                   currPos.first, currPos.second, currDir, range);
+        if (friendly && (!target || friendly <= target))
+            return false; // don't friendly fire
+        return target != 0;
     }
 
-    bool TankAlgorithm_212788293_212497127::isSquareValid(int x, int y, std::set<std::pair<int, int>> cellsToAvoid)
+    bool TankAlgorithm_212788293_212497127::isSquareValid(int x, int y, const UC::CellSet &cellsToAvoid) const
     {
         if (x < 0 || y < 0 || x >= static_cast<int>(gameWidth) || y >= static_cast<int>(gameHeight))
             return false;
 
-        int pos = UC::bijection(x, y);
-        if (mines.count(pos) > 0 || walls.count(pos) > 0 || cellsToAvoid.count(std::make_pair(x, y)))
+        int pos = grid.index(x, y);
+        if (board->mines.contains(pos) || board->walls.contains(pos) || cellsToAvoid.contains(pos))
             return false;
 
         return true;
     }
 
-    std::pair<int, int> TankAlgorithm_212788293_212497127::findFirstLegalLocationToFlee(std::pair<int, int> from, std::set<std::pair<int, int>> redZone)
+    std::pair<int, int> TankAlgorithm_212788293_212497127::findFirstLegalLocationToFlee(std::pair<int, int> from, const std::set<std::pair<int, int>> &redZone)
     {
         using Pos = std::pair<int, int>;
         using Entry = std::pair<int, Pos>; // cost, position
 
         auto isAdjacentToEnemy = [&](const Pos &pos) -> bool
         {
-            for (const auto &enemy : threats)
+            for (const auto &enemy : board->enemyTanks)
             {
-                std::pair<int, int> enemyPos = UC::inverseBijection(enemy);
+                std::pair<int, int> enemyPos = grid.position(enemy);
                 if (manhattanDistance(pos.first, pos.second, enemyPos.first, enemyPos.second) <= 1)
                     return true;
             }
@@ -124,8 +128,8 @@ namespace Algorithm_212788293_212497127
         auto isSafe = [&](const Pos &pos) -> bool
         {
             return redZone.count(pos) == 0 &&
-                   mines.count(UC::bijection(pos.first, pos.second)) == 0 &&
-                   walls.count(UC::bijection(pos.first, pos.second)) == 0 &&
+                   !board->mines.contains(grid.index(pos.first, pos.second)) &&
+                   !board->walls.contains(grid.index(pos.first, pos.second)) &&
                    !isAdjacentToEnemy(pos);
         };
 
@@ -177,47 +181,72 @@ namespace Algorithm_212788293_212497127
         std::pair<int, int> bestTarget = {-1, -1};
         int minDist = INT_MAX;
 
-        for (int y = 0; y < static_cast<int>(gameHeight); ++y)
+        for (int enemy : board->enemyTanks)
         {
-            for (int x = 0; x < static_cast<int>(gameWidth); ++x)
-            {
-                int pos = UC::bijection(x, y);
-                if (threats.count(pos) > 0)
-                {
-                    int dist = manhattanDistance(myPos.first, myPos.second, x, y);
+            std::pair<int, int> pos = grid.position(enemy);
+            int dist = manhattanDistance(myPos.first, myPos.second, pos.first, pos.second);
 
-                    if (dist < minDist)
-                    {
-                        minDist = dist;
-                        bestTarget = {x, y};
-                    }
-                }
+            if (dist < minDist)
+            {
+                minDist = dist;
+                bestTarget = pos;
             }
         }
         return (bestTarget.first == -1) ? std::pair<int, int>{0, 0} : bestTarget;
     }
 
-    std::vector<std::pair<int, int>> TankAlgorithm_212788293_212497127::getPath(std::pair<int, int> start, std::pair<int, int> target, std::set<std::pair<int, int>> avoidCells)
+    std::vector<std::pair<int, int>> TankAlgorithm_212788293_212497127::getPath(std::pair<int, int> start, std::pair<int, int> target, const std::set<std::pair<int, int>> &avoidCells, PathCost cost)
+    {
+        avoidMask.reset(grid.size());
+        for (const auto &cell : avoidCells)
+        {
+            if (cell.first >= 0 && cell.second >= 0 && cell.first < gameWidth && cell.second < gameHeight)
+                avoidMask.insert(grid.index(cell.first, cell.second));
+        }
+        return getPath(start, target, avoidMask, cost);
+    }
+
+    std::vector<std::pair<int, int>> TankAlgorithm_212788293_212497127::getPath(std::pair<int, int> start, std::pair<int, int> target, const UC::CellSet &avoidCells, PathCost cost)
     {
-        std::queue<std::pair<int, int>> queue;
-        std::unordered_map<std::pair<int, int>, bool, UC::pair_hash> visited;
-        std::unordered_map<std::pair<int, int>, std::pair<int, int>, UC::pair_hash> parent;
+        auto onBoard = [&](std::pair<int, int> pos)
+        {
+            return pos.first >= 0 && pos.second >= 0 && pos.first < gameWidth && pos.second < gameHeight;
+        };
+        if (!onBoard(start))
+            return {};
 
-        queue.push(start);
-        visited[start] = true;
+        const int from = grid.index(start.first, start.second);
+        const int to = onBoard(target) ? grid.index(target.first, target.second) : -1;
+        if (to != from)
+        {
+            // the search never enters a blocked or avoided target, and it cannot join cells
+            // that walls and mines alone already separate, so skip flooding the whole area
+            if (to == -1 || avoidCells.contains(to))
+                return {};
+            if (board->distanceFields && !board->distanceFields->getObstacles().contains(from) && !board->distanceFields->connected(from, to))
+                return {};
+        }
+
+        beginSearch();
+        if (cost == PathCost::Actions)
+            return getActionPath(from, to, avoidCells);
 
-        while (!queue.empty())
+        // every cell enters the queue at most once, so the grid-sized buffer never overflows
+        size_t head = 0, tail = 0;
+        frontier[tail++] = from;
+        visitedEpoch[from] = searchEpoch;
+
+        while (head < tail)
         {
-            auto current = queue.front();
-            queue.pop();
+            int current = frontier[head++];
 
-            if (current == target)
+            if (current == to)
             {
                 std::vector<std::pair<int, int>> path;
-                while (current != start)
+                while (current != from)
                 {
-                    path.push_back(current);
-                    current = parent[current];
+                    path.push_back(grid.position(current));
+                    current = parentCell[current];
                 }
                 std::reverse(path.begin(), path.end());
 
@@ -226,12 +255,13 @@ namespace Algorithm_212788293_212497127
 
             for (const auto &dir : UC::DirectionsUtils::directions)
             {
-                auto next = moveTank(current, dir);
-                if (!visited[next] && isSquareValid(next.first, next.second, avoidCells))
+                auto next = moveTank(grid.position(current), dir);
+                int id = grid.index(next.first, next.second);
+                if (visitedEpoch[id] != searchEpoch && isSquareValid(next.first, next.second, avoidCells))
                 {
-                    visited[next] = true;
-                    parent[next] = current;
-                    queue.push(next);
+                    visitedEpoch[id] = searchEpoch;
+                    parentCell[id] = current;
+                    frontier[tail++] = id;
                 }
             }
         }
@@ -239,6 +269,93 @@ namespace Algorithm_212788293_212497127
         return {};
     }
 
+    void TankAlgorithm_212788293_212497127::beginSearch()
+    {
+        const int cells = grid.size();
+        if (static_cast<int>(visitedEpoch.size()) != cells)
+        {
+            visitedEpoch.assign(cells, 0);
+            parentCell.assign(cells, -1);
+            frontier.assign(cells, 0);
+            stateEpoch.assign(static_cast<size_t>(cells) * 8, 0);
+            stateCost.assign(static_cast<size_t>(cells) * 8, 0);
+            stateParent.assign(static_cast<size_t>(cells) * 8, -1);
+            searchEpoch = 0;
+        }
+        if (++searchEpoch == 0)
+        {
+            std::fill(visitedEpoch.begin(), visitedEpoch.end(), 0);
+            std::fill(stateEpoch.begin(), stateEpoch.end(), 0);
+            searchEpoch = 1;
+        }
+    }
+
+    std::vector<std::pair<int, int>> TankAlgorithm_212788293_212497127::getActionPath(int from, int to, const UC::CellSet &avoidCells)
+    {
+        // A* over (cell, facing) states: driving into a neighbour costs the rotations that
+        // Role::rotateTowards spends to face it plus the forward move. The toroidal Chebyshev
+        // distance counts the moves still needed, so it never overestimates.
+        auto rotationCost = [](UC::Direction from, UC::Direction to)
+        {
+            static constexpr int byEighths[8] = {0, 1, 1, 2, 2, 2, 1, 1};
+            return byEighths[UC::DirectionsUtils::eighthsBetween(from, to)];
+        };
+        const std::pair<int, int> goal = grid.position(to);
+        auto heuristic = [&](std::pair<int, int> pos)
+        {
+            int dx = std::abs(pos.first - goal.first), dy = std::abs(pos.second - goal.second);
+            return std::max(std::min(dx, gameWidth - dx), std::min(dy, gameHeight - dy));
+        };
+
+        // (f, -g, state): cheapest estimate first, and among those the one that got furthest
+        using Entry = std::tuple<int, int, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+
+        const int startState = from * 8 + currentDirection;
+        stateEpoch[startState] = searchEpoch;
+        stateCost[startState] = 0;
+        stateParent[startState] = -1;
+        open.push({heuristic(grid.position(from)), 0, startState});
+
+        while (!open.empty())
+        {
+            auto [estimate, negCost, state] = open.top();
+            open.pop();
+            if (-negCost != stateCost[state])
+                continue; // superseded by a cheaper route to the same state
+
+            const int cell = state / 8;
+            if (cell == to)
+            {
+                std::vector<std::pair<int, int>> path;
+                for (; state != startState; state = stateParent[state])
+                    path.push_back(grid.position(state / 8));
+                std::reverse(path.begin(), path.end());
+                return path;
+            }
+
+            const auto facing = static_cast<UC::Direction>(state % 8);
+            for (UC::Direction dir : UC::DirectionsUtils::directions)
+            {
+                auto next = moveTank(grid.position(cell), dir);
+                if (!isSquareValid(next.first, next.second, avoidCells))
+                    continue;
+
+                const int nextState = grid.index(next.first, next.second) * 8 + dir;
+                const int cost = stateCost[state] + rotationCost(facing, dir) + 1;
+                if (stateEpoch[nextState] == searchEpoch && stateCost[nextState] <= cost)
+                    continue;
+
+                stateEpoch[nextState] = searchEpoch;
+                stateCost[nextState] = cost;
+                stateParent[nextState] = state;
+                open.push({cost + heuristic(next), -cost, nextState});
+            }
+        }
+
+        return {};
+    }
+
     int TankAlgorithm_212788293_212497127::manhattanDistance(int x1, int y1, int x2, int y2) const
     {
         return std::abs(x1 - x2) + std::abs(y1 - y2);
@@ -260,7 +377,7 @@ namespace Algorithm_212788293_212497127
                 int nx = (x + dx + gameWidth) % gameWidth;
                 int ny = (y + dy + gameHeight) % gameHeight;
 
-                if (walls.count(UC::bijection(nx, ny)) > 0)
+                if (board->walls.contains(grid.index(nx, ny)))
                     wallCount++;
             }
         }
@@ -274,11 +391,11 @@ namespace Algorithm_212788293_212497127
         {
             for (int j = currentPos.second - range; j <= currentPos.second + range; ++j)
             {
-                int x = (i + gameWidth) % gameWidth;
-                int y = (j + gameHeight) % gameHeight;
-                int pos = UC::bijection(x, y);
+                int x = (i % gameWidth + gameWidth) % gameWidth;
+                int y = (j % gameHeight + gameHeight) % gameHeight;
+                int pos = grid.index(x, y);
 
-                if (threats.count(pos) > 0)
+                if (board->enemyTanks.contains(pos))
                 {
                     return true;
                 }
@@ -293,14 +410,26 @@ namespace Algorithm_212788293_212497127
         int minPath = INT_MAX;
         std::pair<int, int> candidate = {-1, -1};
 
-        for (int id : nearbyFriendlies)
+        // one search from `from` measures the path to every friendly; an unreachable one
+        // counts as an empty path, as getPath would return
+        UC::CellSet blocked = board->walls;
+        blocked |= board->mines;
+        for (const auto &cell : bannedPositionsForTank)
         {
-            if (id == UC::bijection(from.first, from.second))
+            if (cell.first >= 0 && cell.second >= 0 && cell.first < gameWidth && cell.second < gameHeight)
+                blocked.insert(grid.index(cell.first, cell.second));
+        }
+        DistanceField field;
+        field.build(grid, {grid.index(from.first, from.second)}, blocked);
+
+        for (int id : board->friendlyTanks)
+        {
+            if (id == grid.index(from.first, from.second))
                 continue;
-            std::pair<int, int> pos = UC::inverseBijection(id);
-            size_t pathLength = getPath(from, pos, bannedPositionsForTank).size();
+            std::pair<int, int> pos = grid.position(id);
+            size_t pathLength = field.reachable(id) ? field.distance(id) : 0;
 
-            if (pathLength < (size_t)minPath)
+            if (pathLength < (size_t)minPath || (pathLength == (size_t)minPath && diagonalBefore(pos, candidate)))
             {
                 minPath = pathLength;
                 candidate = pos;
@@ -321,19 +450,14 @@ namespace Algorithm_212788293_212497127
     std::optional<std::pair<int, int>> TankAlgorithm_212788293_212497127::findEnemyInRange(std::pair<int, int> position, int range)
     {
 
-        for (int i = 0; i < 8; ++i)
+        for (UC::Direction dir : UC::DirectionsUtils::directions)
         {
-            for (int j = 1; j <= range; ++j)
+            int j = board->rays.firstHit(UC::RayBoard::Enemy, position.first, position.second, dir, range);
+            if (j)
             {
-
-                int x = (position.first + UC::DirectionsUtils::stringToIntDirection[UC::DirectionsUtils::directions[i]][0] * j + gameWidth * j) % gameWidth;
-                int y = (position.second + UC::DirectionsUtils::stringToIntDirection[UC::DirectionsUtils::directions[i]][1] * j + gameHeight * j) % gameHeight;
-                int pos = UC::bijection(x, y);
-
-                if (threats.count(pos) > 0)
-                {
-                    return std::make_pair(x, y);
-                }
+                int x = (position.first + UC::DirectionsUtils::stringToIntDirection[dir][0] * j + gameWidth * j) % gameWidth;
+                int y = (position.second + UC::DirectionsUtils::stringToIntDirection[dir][1] * j + gameHeight * j) % gameHeight;
+                return std::make_pair(x, y);
             }
         }
         return std::nullopt;
@@ -342,9 +466,9 @@ namespace Algorithm_212788293_212497127
     std::set<std::pair<int, int>> TankAlgorithm_212788293_212497127::getShells()
     {
         std::set<std::pair<int, int>> shellsXY;
-        for (const auto pos : shells)
+        for (const auto pos : board->shells)
         {
-            shellsXY.insert(UC::inverseBijection(pos));
+            shellsXY.insert(grid.position(pos));
         }
         return shellsXY;
     }
@@ -354,12 +478,12 @@ namespace Algorithm_212788293_212497127
 
         std::pair<int, int> closestWall;
         int dist, minDist = INT_MAX;
-        for (auto &wall : walls)
+        for (int wall : board->walls)
         {
-            std::pair<int, int> wallPos = UC::inverseBijection(wall);
+            std::pair<int, int> wallPos = grid.position(wall);
             dist = manhattanDistance(pos.first, pos.second, wallPos.first, wallPos.second);
 
-            if (dist < minDist)
+            if (dist < minDist || (dist == minDist && diagonalBefore(wallPos, closestWall)))
             {
                 minDist = dist;
                 closestWall = wallPos;
@@ -5,15 +5,13 @@
 namespace Algorithm_212788293_212497127
 {
     MyPlayer::MyPlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells)
-        : player_index(player_index), playerGameWidth(x), playerGameHeight(y), max_steps(max_steps), num_shells(num_shells) {}
+        : player_index(player_index), playerGameWidth(x), playerGameHeight(y),
+          grid(static_cast<int>(x), static_cast<int>(y)), max_steps(max_steps), num_shells(num_shells) {}
 
     void MyPlayer::updateTankWithBattleInfo(TankAlgorithm &tank, SatelliteView &satellite_view)
     {
-        ;
-        std::set<int> friendlyTanks, enemyTanks, mines, walls, shells;
-
         int myX = -1, myY = -1;
-        std::pair<int, int> tankPos = prepareInfoForBattleInfo(mines, walls, shells, friendlyTanks, enemyTanks, satellite_view);
+        std::pair<int, int> tankPos = prepareInfoForBattleInfo(satellite_view);
 
         if (!gotBattleInfo)
         {
@@ -23,17 +21,25 @@ namespace Algorithm_212788293_212497127
         myX = tankPos.first;
         myY = tankPos.second;
 
-        MyBattleInfo info(playerGameWidth, playerGameHeight, friendlyTanks, enemyTanks, mines, walls, shells);
+        if (obstaclesChanged)
+        {
+            auto fields = std::make_shared<DistanceFieldCache>();
+            fields->update(grid, board->walls, board->mines);
+            editableBoard().distanceFields = std::move(fields);
+            obstaclesChanged = false;
+        }
+
+        MyBattleInfo info(board);
 
         info.setMyXPosition(myX);
         info.setMyYPosition(myY);
 
         int tankId = getTankId({myX, myY});
 
-        EnemyScanResult scan = assignRole(tankId, {myX, myY}, shells, enemyTanks, friendlyTanks.size());
+        EnemyScanResult scan = assignRole(tankId, {myX, myY}, board->shells, board->enemyTanks, board->friendlyTanks.size());
         if (!scan.ShouldKeepRole)
         {
-            info.setRole(createRole(tankId, {myX, myY}, scan, shells, enemyTanks, friendlyTanks.size()));
+            info.setRole(createRole(tankId, {myX, myY}, scan, board->shells, board->enemyTanks, board->friendlyTanks.size()));
             info.setShouldKeepRole(false);
         }
         else
@@ -41,8 +47,7 @@ namespace Algorithm_212788293_212497127
             info.setShouldKeepRole(true);
         }
 
-        std::set<std::pair<int, int>> planned = getCalculatedPathsSet();
-        info.setPlannedPositions(planned);
+        info.setPlannedPositions(getCalculatedPathsSet());
         tank.updateBattleInfo(info);
         tanksPlannedActions[tankId] = info.getPlannedActions();
         tanksPlannedPaths[tankId] = info.getPath();
@@ -82,10 +87,10 @@ namespace Algorithm_212788293_212497127
         tankRoles.erase(tankId);
     }
 
-    EnemyScanResult MyPlayer::assignRole(int tankId, std::pair<int, int> pos, std::set<int> shells, std::set<int> enemyTanks, int numFriendlyTanks)
+    EnemyScanResult MyPlayer::assignRole(int tankId, std::pair<int, int> pos, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int numFriendlyTanks)
     {
 
-        EnemyScanResult scan = scanVisibleEnemies(pos.first, pos.second);
+        EnemyScanResult scan = scanVisibleEnemies(pos.first, pos.second, enemyTanks);
 
         bool surrounded = true;
         bool isStuck = true;
@@ -137,24 +142,28 @@ namespace Algorithm_212788293_212497127
         return bannedPositionsSet;
     }
 
-    EnemyScanResult MyPlayer::scanVisibleEnemies(int x0, int y0) const
+    EnemyScanResult MyPlayer::scanVisibleEnemies(int x0, int y0, const UC::CellSet &enemyTanks) const
     {
-
-        const char enemyChar = (player_index == 1) ? '2' : '1';
         EnemyScanResult result;
-        for (int y = 0; y < (int)lastSatellite.size(); ++y)
+        for (int enemy : enemyTanks)
         {
-            for (int x = 0; x < (int)lastSatellite[0].size(); ++x)
-            {
-                if (lastSatellite[y][x] == enemyChar)
-                {
-                    int dist = manhattanDistance(x0, y0, x, y);
-                    if (dist < result.closestDistance)
-                        result.closestDistance = dist;
-                    if ((x == x0 || y == y0) && isClearLine(x0, y0, x, y))
-                        result.hasLineOfSight = true;
-                }
-            }
+            std::pair<int, int> pos = grid.position(enemy);
+            int dist = manhattanDistance(x0, y0, pos.first, pos.second);
+            if (dist < result.closestDistance)
+                result.closestDistance = dist;
+        }
+
+        // an enemy in the same row or column is visible when no wall stands between; the
+        // sight line runs straight towards it without wrapping around the board
+        const int width = static_cast<int>(playerGameWidth), height = static_cast<int>(playerGameHeight);
+        const std::pair<UC::Direction, int> lines[] = {
+            {UC::Direction::R, width - 1 - x0}, {UC::Direction::L, x0}, {UC::Direction::D, height - 1 - y0}, {UC::Direction::U, y0}};
+        for (const auto &[dir, reach] : lines)
+        {
+            int enemy = board->rays.firstHit(UC::RayBoard::Enemy, x0, y0, dir, reach);
+            int wall = board->rays.firstHit(UC::RayBoard::Walls, x0, y0, dir, reach);
+            if (enemy && (!wall || enemy < wall))
+                result.hasLineOfSight = true;
         }
         return result;
     }
@@ -164,37 +173,6 @@ namespace Algorithm_212788293_212497127
         return std::abs(x1 - x2) + std::abs(y1 - y2);
     }
 
-    bool MyPlayer::isClearLine(int x1, int y1, int x2, int y2) const
-    {
-        int dx = x2 - x1;
-        int dy = y2 - y1;
-
-        // Normalize direction to one of 8 (if not aligned, return false)
-        if (dx != 0)
-            dx /= std::abs(dx);
-        if (dy != 0)
-            dy /= std::abs(dy);
-
-        if ((x1 + dx + (int)playerGameWidth) % (int)playerGameWidth == x2 &&
-            (y1 + dy + (int)playerGameHeight) % (int)playerGameHeight == y2)
-        {
-            return true; // adjacent cell
-        }
-
-        int x = (x1 + dx + (int)playerGameWidth) % (int)playerGameWidth;
-        int y = (y1 + dy + (int)playerGameHeight) % (int)playerGameHeight;
-
-        while (x != x2 || y != y2)
-        {
-            if (lastSatellite[y][x] == '#')
-                return false;
-
-            x = (x + dx + playerGameWidth) % playerGameWidth;
-            y = (y + dy + playerGameHeight) % playerGameHeight;
-        }
-        return true;
-    }
-
     bool MyPlayer::isInOpen(int x, int y) const
     {
         int wallCount = 0;
@@ -215,58 +193,115 @@ namespace Algorithm_212788293_212497127
         return wallCount <= 3;
     }
 
-    std::pair<int, int> MyPlayer::prepareInfoForBattleInfo(std::set<int> &mines, std::set<int> &walls, std::set<int> &shells, std::set<int> &friendlyTanks, std::set<int> &enemyTanks, SatelliteView &satellite_view)
+    std::pair<int, int> MyPlayer::prepareInfoForBattleInfo(SatelliteView &satellite_view)
     {
-        int myX = -1, myY = -1;
+        if (lastSatellite.empty())
+        {
+            lastSatellite.assign(playerGameHeight, std::vector<char>(playerGameWidth, ' '));
+            board = std::make_shared<BoardSnapshot>();
+            board->grid = grid;
+            for (auto *cells : {&board->friendlyTanks, &board->enemyTanks, &board->mines, &board->walls, &board->shells})
+                cells->reset(grid.size());
+            board->rays.reset(playerGameWidth, playerGameHeight);
+            obstaclesChanged = true;
+        }
 
-        lastSatellite.assign(playerGameHeight, std::vector<char>(playerGameWidth, ' '));
+        // rows are read in place from the view's storage when it has one; the row with the
+        // '%' cell, and every row of other views, is copied out first
+        const UC::SatelliteSpan whole = UC::satelliteSpan(satellite_view);
+        const bool inPlace = !whole.empty() && whole.width == playerGameWidth && whole.height == playerGameHeight;
+        incomingRow.resize(playerGameWidth);
         for (size_t i = 0; i < playerGameHeight; ++i)
         {
+            const char *row = incomingRow.data();
+            if (inPlace && whole.self / playerGameWidth != i)
+                row = whole.cells + i * playerGameWidth;
+            else
+                UC::copySatelliteRow(satellite_view, i, playerGameWidth, incomingRow.data());
+            if (std::equal(row, row + playerGameWidth, lastSatellite[i].begin()))
+                continue;
             for (size_t j = 0; j < playerGameWidth; ++j)
             {
-                char object = satellite_view.getObjectAt(j, i);
-                int id = UC::bijection(j, i);
-                lastSatellite[i][j] = object;
-                if (object == '%')
-                {
-                    friendlyTanks.insert(id);
-                    myX = j;
-                    myY = i;
-                }
-                else if (object == '@')
-                    mines.insert(id);
-                else if (object == '#')
-                    walls.insert(id);
-                else if (object == '*')
-                    shells.insert(id);
-                else if (object >= '0' && object <= '9')
-                {
-                    int tankOwner = object - '0';
-
-                    if (tankOwner == player_index)
-                        friendlyTanks.insert(id);
-                    else
-                        enemyTanks.insert(id);
-                }
+                if (row[j] != lastSatellite[i][j])
+                    applyCell(j, i, row[j]);
             }
         }
-        return std::make_pair(myX, myY);
+
+        if (selfCell == -1)
+            return std::make_pair(-1, -1);
+        return grid.position(selfCell);
+    }
+
+    void MyPlayer::applyCell(int x, int y, char object)
+    {
+        char &cell = lastSatellite[y][x];
+        const int id = grid.index(x, y);
+        const UC::RayBoard::Layer before = layerOf(cell), after = layerOf(object);
+
+        if (cell == '%' && selfCell == id)
+            selfCell = -1;
+        if (object == '%')
+            selfCell = id;
+        cell = object;
+
+        if (before == after)
+            return;
+        BoardSnapshot &next = editableBoard();
+        if (before != UC::RayBoard::LAYER_COUNT)
+        {
+            next.cellsOf(before).erase(id);
+            next.rays.clear(before, x, y);
+        }
+        if (after != UC::RayBoard::LAYER_COUNT)
+        {
+            next.cellsOf(after).insert(id);
+            next.rays.set(after, x, y);
+        }
+        for (UC::RayBoard::Layer layer : {before, after})
+        {
+            if (layer == UC::RayBoard::Walls || layer == UC::RayBoard::Mines)
+                obstaclesChanged = true;
+        }
+    }
+
+    // the index a satellite symbol belongs to; LAYER_COUNT for empty ground
+    UC::RayBoard::Layer MyPlayer::layerOf(char object) const
+    {
+        if (object == '%')
+            return UC::RayBoard::Friendly;
+        if (object == '@')
+            return UC::RayBoard::Mines;
+        if (object == '#')
+            return UC::RayBoard::Walls;
+        if (object == '*')
+            return UC::RayBoard::Shells;
+        if (object >= '0' && object <= '9')
+            return object - '0' == player_index ? UC::RayBoard::Friendly : UC::RayBoard::Enemy;
+        return UC::RayBoard::LAYER_COUNT;
+    }
+
+    // tanks may still hold the current snapshot, so it is copied before the first change
+    BoardSnapshot &MyPlayer::editableBoard()
+    {
+        if (board.use_count() > 1)
+            board = std::make_shared<BoardSnapshot>(*board);
+        return *board;
     }
 
-    bool MyPlayer::isInRedZone(int x, int y, std::set<int> shellsPositions, std::set<int> enemies) const
+    bool MyPlayer::isInRedZone(int x, int y, const UC::CellSet &shellsPositions, const UC::CellSet &enemies) const
     {
         std::pair<int, int> pos = {x, y};
 
         for (const auto &shellPos : shellsPositions)
         {
-            std::pair<int, int> shell = UC::inverseBijection(shellPos);
+            std::pair<int, int> shell = grid.position(shellPos);
             if (manhattanDistance(pos.first, pos.second, shell.first, shell.second) <= 3)
                 return true;
         }
 
         for (const auto &enemyId : enemies)
         {
-            std::pair<int, int> enemyPos = UC::inverseBijection(enemyId);
+            std::pair<int, int> enemyPos = grid.position(enemyId);
             if (manhattanDistance(x, y, enemyPos.first, enemyPos.second) <= 4)
                 return true;
         }
@@ -318,19 +353,19 @@ namespace Algorithm_212788293_212497127
         {
             if (action == ActionRequest::RotateLeft45)
             {
-                lastDir += 0.875;
+                lastDir = UC::DirectionsUtils::rotate(lastDir, -1);
             }
             else if (action == ActionRequest::RotateLeft90)
             {
-                lastDir += 0.75;
+                lastDir = UC::DirectionsUtils::rotate(lastDir, -2);
             }
             else if (action == ActionRequest::RotateRight90)
             {
-                lastDir += 0.25;
+                lastDir = UC::DirectionsUtils::rotate(lastDir, 2);
             }
             else if (action == ActionRequest::RotateRight45)
             {
-                lastDir += 0.125;
+                lastDir = UC::DirectionsUtils::rotate(lastDir, 1);
             }
         }
         return lastDir;
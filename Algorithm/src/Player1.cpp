@@ -6,7 +6,7 @@ namespace Algorithm_212788293_212497127
 
     REGISTER_PLAYER(Player_212788293_212497127);
 
-    std::unique_ptr<Algorithm_212788293_212497127::Role> Player_212788293_212497127::createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int)
+    std::unique_ptr<Algorithm_212788293_212497127::Role> Player_212788293_212497127::createRole(int tankId, std::pair<int, int> pos, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int)
     {
         int x = pos.first, y = pos.second;
         if (scan.isStuck)
@@ -42,7 +42,7 @@ namespace Algorithm_212788293_212497127
         return std::make_unique<ChaserRole>(5, playerGameWidth, playerGameHeight);
     }
 
-    bool Player_212788293_212497127::shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, std::set<int> shells, std::set<int> enemyTanks, int)
+    bool Player_212788293_212497127::shouldKeepRole(int tankId, const std::pair<int, int> &pos, const std::string &role, EnemyScanResult scan, const UC::CellSet &shells, const UC::CellSet &enemyTanks, int)
     {
         int remainingShells = tanksRemainingShells[tankId];
 
@@ -10,7 +10,7 @@ namespace Algorithm_212788293_212497127
         std::pair<int, int> myPos = algo.getCurrentPosition();
         UC::Direction currentDirection = algo.getCurrentDirection();
         std::pair<int, int> target = algo.getTargetForTank();
-        std::vector<std::pair<int, int>> path = algo.getPath(myPos, target, algo.getBannedPositionsForTank());
+        std::vector<std::pair<int, int>> path = algo.getPath(myPos, target, algo.getBannedPositionsForTank(), getPathCost());
         algo.setBFSPath(path);
 
         if (path.empty())
@@ -11,10 +11,10 @@ namespace Algorithm_212788293_212497127
 
         std::set<std::pair<int, int>> redZone = createRedZone(shells, 5);
         concatenateSets(redZone, algo.getBannedPositionsForTank());
-        concatenateSets(redZone, createRedZone(transformToPairs(algo.getEnemyTanks()), 2));
+        concatenateSets(redZone, createRedZone(transformToPairs(algo.getEnemyTanks(), algo.getGrid()), 2));
    
         std::pair<int, int> target = algo.findFirstLegalLocationToFlee(myPos, redZone);
-        path = algo.getPath(myPos, target, redZone);
+        path = algo.getPath(myPos, target, redZone, getPathCost());
         if (path.empty())
         {
             if (algo.shouldShoot(algo.getCurrentDirection(), algo.getCurrentPosition()))
@@ -96,12 +96,12 @@ namespace Algorithm_212788293_212497127
         }
     }
 
-    std::set<std::pair<int, int>> EvasiorRole::transformToPairs(std::set<int> toBeTransformed)
+    std::set<std::pair<int, int>> EvasiorRole::transformToPairs(const UC::CellSet &toBeTransformed, const UC::GridIndex &grid)
     {
         std::set<std::pair<int, int>> pairsSet;
         for (const auto pos : toBeTransformed)
         {
-            pairsSet.insert(UC::inverseBijection(pos));
+            pairsSet.insert(grid.position(pos));
         }
         return pairsSet;
     }
@@ -19,7 +19,7 @@ namespace Algorithm_212788293_212497127
         {
             nextMoves.push_back(ActionRequest::RotateRight45);
             step++;
-            currentDirection += 0.125;
+            currentDirection = UC::DirectionsUtils::rotate(currentDirection, 1);
             if (step >= maxMovesPerUpdate)
                 return step;
             nextMoves.push_back(ActionRequest::RotateRight90);
@@ -28,7 +28,7 @@ namespace Algorithm_212788293_212497127
         {
             nextMoves.push_back(ActionRequest::RotateRight90);
             step++;
-            currentDirection += 0.25;
+            currentDirection = UC::DirectionsUtils::rotate(currentDirection, 2);
             if (step >= maxMovesPerUpdate)
                 return step;
             nextMoves.push_back(ActionRequest::RotateRight90);
@@ -36,7 +36,7 @@ namespace Algorithm_212788293_212497127
         else if (angle == 0.625)
         {
             nextMoves.push_back(ActionRequest::RotateLeft90);
-            currentDirection += 0.75;
+            currentDirection = UC::DirectionsUtils::rotate(currentDirection, -2);
             step++;
             if (step >= maxMovesPerUpdate)
                 return step;
@@ -78,24 +78,13 @@ namespace Algorithm_212788293_212497127
         dx = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
         dy = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
 
-        return UC::DirectionsUtils::pairToDirections[{dx, dy}];
+        return UC::DirectionsUtils::pairToDirection(dx, dy);
     }
 
     double Role::getAngleFromDirections(UC::Direction &orgDir, UC::Direction &desiredDir)
     {
-        UC::Direction dirToCheck;
-        double angle, rotate = 0.125;
-        for (int i = 0; i < 8; ++i)
-        {
-            angle = i * rotate;
-            dirToCheck = orgDir;
-            dirToCheck += (angle);
-            if (dirToCheck == desiredDir)
-            {
-                return angle;
-            }
-        }
-        return 0.0; // Should not happen, but just in case
+        // clockwise turn from orgDir to desiredDir, in fractions of a full turn
+        return UC::DirectionsUtils::eighthsBetween(orgDir, desiredDir) * 0.125;
     }
 
     ActionRequest Role::getNextAction()
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "UserCommon/VerboseOutput.h"
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace GameManager_212788293_212497127
+{
+    // Bytes queued for one output file: a single-producer / single-consumer ring.
+    // The game thread appends at `head`, the sink's writer thread drains from `tail`.
+    struct AsyncChannel
+    {
+        std::FILE *file{};
+        std::unique_ptr<char[]> ring;
+        size_t capacity{}; // power of two
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+        std::atomic<bool> closed{false};
+    };
+
+    // a producer stall is a push that found its ring full
+    using AsyncSinkStats = UC::VerboseOutputStats;
+
+    // ========================= CLASS: AsyncFileSink =========================
+    // Process-wide writer for verbose output. Game threads only copy bytes into their
+    // channel's ring; one background thread performs all file I/O in large batches.
+    // Memory is bounded by the ring size per open file: a producer whose ring is full
+    // waits for the writer, and the wait is accounted in the stats.
+
+    class AsyncFileSink
+    {
+    public:
+        static constexpr size_t RING_CAPACITY = 1 << 18;
+
+        static AsyncFileSink &instance();
+        ~AsyncFileSink();
+
+        std::shared_ptr<AsyncChannel> open(const std::string &path);
+        void push(AsyncChannel &channel, const char *data, size_t size);
+        void close(const std::shared_ptr<AsyncChannel> &channel);
+
+        // blocks until everything queued so far is written
+        void drain();
+        AsyncSinkStats stats() const;
+
+    private:
+        AsyncFileSink() = default;
+        void run();
+        bool drainChannel(AsyncChannel &channel);
+        void wake();
+
+        mutable std::mutex mutex;
+        std::condition_variable work;
+        std::condition_variable idle;
+        std::vector<std::shared_ptr<AsyncChannel>> channels;
+        std::thread writer;
+        bool stopping{false};
+        bool pendingWork{false};
+        std::uint64_t passes{0};
+
+        std::atomic<std::uint64_t> bytesWritten{0};
+        std::atomic<std::uint64_t> writeCalls{0};
+        std::atomic<std::uint64_t> producerStalls{0};
+        std::atomic<std::uint64_t> stallMicroseconds{0};
+    };
+
+    // ========================= CLASS: AsyncFileWriter =========================
+    // ostream-like producer handle on an AsyncFileSink channel. Output is staged locally and
+    // handed to the ring in chunks, so formatting never touches the file system.
+
+    class AsyncFileWriter
+    {
+    private:
+        static constexpr size_t STAGING_SIZE = 1 << 14;
+
+        std::shared_ptr<AsyncChannel> channel;
+        std::string staged;
+
+        void stage(const char *data, size_t size)
+        {
+            staged.append(data, size);
+            if (staged.size() >= STAGING_SIZE)
+                flush();
+        }
+
+    public:
+        AsyncFileWriter() = default;
+        AsyncFileWriter(const AsyncFileWriter &) = delete;
+        AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+        ~AsyncFileWriter() { close(); }
+
+        bool open(const std::string &path);
+        bool is_open() const { return channel != nullptr; }
+        void flush();
+        void close();
+
+        void write(const char *data, size_t size)
+        {
+            if (channel)
+                stage(data, size);
+        }
+
+        AsyncFileWriter &operator<<(std::string_view text)
+        {
+            write(text.data(), text.size());
+            return *this;
+        }
+
+        AsyncFileWriter &operator<<(char c)
+        {
+            write(&c, 1);
+            return *this;
+        }
+
+        template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        AsyncFileWriter &operator<<(T value)
+        {
+            char digits[24];
+            std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+            write(digits, static_cast<size_t>(result.ptr - digits));
+            return *this;
+        }
+    };
+}
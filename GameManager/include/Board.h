@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Snapshot.h"
+#include "UserCommon/CellIndex.h"
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace GameManager_212788293_212497127
+{
+    // What currently sits in a board cell (bitmask, a tank can share a cell with a shell or a mine)
+    enum CellKind : std::uint8_t
+    {
+        EmptyCell = 0,
+        WallCell = 1 << 0,
+        MineCell = 1 << 1,
+        TankCell = 1 << 2,
+        ShellCell = 1 << 3
+    };
+
+    struct Cell
+    {
+        std::uint8_t kind{EmptyCell};
+        std::uint8_t owner{0};  // player id of the tank in this cell
+        std::int8_t health{0};  // wall health
+        std::int32_t tank{-1};  // index into GameManager::tanks
+        std::int32_t shell{-1}; // index into GameManager::shells
+    };
+
+    // ========================= CLASS: Board =========================
+    // Dense occupancy grid over the doubled coordinate space (width*2 x height*2),
+    // cells are addressed by index = y * width + x. Every change marks the map cell
+    // (x / 2, y / 2) it falls in as dirty, so the visualization can be updated incrementally.
+
+    class Board
+    {
+    private:
+        int width{};
+        int height{};
+        UC::GridIndex grid;    // doubled coordinates
+        UC::GridIndex mapGrid; // map cells, (x / 2, y / 2)
+        std::vector<Cell> cells;
+
+        // map cells (index = (y / 2) * (width / 2) + x / 2) changed since the last clearDirty()
+        std::vector<int> dirtyCells;
+        std::vector<std::uint8_t> dirtyFlags;
+
+        void markDirty(int idx)
+        {
+            int cell = mapGrid.index(grid.xOf(idx) / 2, grid.yOf(idx) / 2);
+            if (!dirtyFlags[cell])
+            {
+                dirtyFlags[cell] = 1;
+                dirtyCells.push_back(cell);
+            }
+        }
+
+    public:
+        void reset(int doubledWidth, int doubledHeight);
+
+        // only walls and mines are saved, tank and shell occupancy is rebuilt from the entity stores
+        void save(SnapshotWriter &out) const;
+        void load(SnapshotReader &in);
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        int size() const { return width * height; }
+
+        int index(int x, int y) const { return grid.index(x, y); }
+        int xOf(int idx) const { return grid.xOf(idx); }
+        int yOf(int idx) const { return grid.yOf(idx); }
+        const UC::GridIndex &getMapGrid() const { return mapGrid; }
+
+        const Cell &at(int idx) const { return cells[idx]; }
+
+        const std::vector<int> &getDirtyCells() const { return dirtyCells; }
+        void clearDirty();
+
+        // Walls
+        void addWall(int idx, std::int8_t health);
+        bool hasWall(int idx) const { return cells[idx].kind & WallCell; }
+        int damageWall(int idx);
+        void removeWall(int idx);
+
+        // Mines
+        void addMine(int idx);
+        bool hasMine(int idx) const { return cells[idx].kind & MineCell; }
+        void removeMine(int idx);
+
+        // Tanks
+        void placeTank(int idx, int tank, int owner);
+        int tankAt(int idx) const { return cells[idx].tank; }
+        void clearTank(int idx);
+
+        // Shells
+        void placeShell(int idx, int shell);
+        int shellAt(int idx) const { return cells[idx].shell; }
+        void clearShell(int idx);
+    };
+}
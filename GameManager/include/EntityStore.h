@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "common/ActionRequest.h"
+#include "common/TankAlgorithm.h"
+#include "UserCommon/DirectionUtils.h"
+#include "Snapshot.h"
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace GameManager_212788293_212497127
+{
+    // Reference to a pooled entity; stale once the slot is released and reused
+    struct EntityHandle
+    {
+        std::int32_t index{-1};
+        std::uint32_t generation{0};
+    };
+
+    // ========================= CLASS: TankStore =========================
+    // Structure-of-arrays storage for tanks, row i is the tank with global id i.
+
+    class TankStore
+    {
+    public:
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<UC::Direction> direction;
+        std::vector<int> playerId;
+        std::vector<int> tankId;
+        std::vector<int> artilleryShells;
+        std::vector<int> cantShoot;
+        std::vector<int> reverseCharge;
+        std::vector<std::uint8_t> reverseQueued;
+        std::vector<std::uint8_t> reverseReady;
+        std::vector<std::uint8_t> alive;
+        std::vector<ActionRequest> lastMove;
+        std::vector<std::unique_ptr<TankAlgorithm>> algorithms;
+
+        int size() const { return static_cast<int>(alive.size()); }
+        int add(int x, int y, UC::Direction dir, int playerId, int shells, int tankId);
+        void kill(int index);
+        void clear();
+
+        // algorithms are not part of the state, load() leaves an empty one per tank; it throws
+        // for columns of different lengths or values out of range, positions are not checked
+        void save(SnapshotWriter &out) const;
+        void load(SnapshotReader &in);
+    };
+
+    // ========================= CLASS: ShellStore =========================
+    // Structure-of-arrays pool for shells, released slots are recycled through a free list.
+
+    class ShellStore
+    {
+    public:
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<UC::Direction> direction;
+        std::vector<int> firedAt; // game step in which the shell was fired
+        std::vector<std::uint32_t> generation;
+        std::vector<std::uint8_t> alive;
+
+        int size() const { return static_cast<int>(alive.size()); }
+        EntityHandle spawn(int x, int y, UC::Direction dir, int step);
+        void release(int index);
+        bool isValid(EntityHandle handle) const;
+        void clear();
+
+        // load() throws like TankStore::load, and for a free list that does not name dead slots
+        void save(SnapshotWriter &out) const;
+        void load(SnapshotReader &in);
+
+    private:
+        std::vector<int> freeSlots;
+    };
+
+    // Entity storage owned by a GameManager, reused across steps and games
+    struct EntityStore
+    {
+        TankStore tanks;
+        ShellStore shells;
+
+        void clear()
+        {
+            tanks.clear();
+            shells.clear();
+        }
+    };
+}
@@ -1,33 +1,48 @@
 #pragma once
 
-#include <map>
 #include <memory>
 #include <optional>
-#include <set>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <fstream>
 #include <atomic>
+#include <chrono>
 #include "common/AbstractGameManager.h"
+#include "UserCommon/BatchGameManager.h"
+#include "UserCommon/GameBudget.h"
+#include "UserCommon/Replay.h"
+#include "UserCommon/VerboseOutput.h"
+#include "UserCommon/VisualizationFormat.h"
+#include "Board.h"
+#include "EntityStore.h"
+#include "StampGrid.h"
+#include "Snapshot.h"
+#include "ReplayWriter.h"
+#include "AsyncFileSink.h"
 
 class MySatelliteView;
 
 namespace GameManager_212788293_212497127
 {
-    // Walls live in doubled coordinates like other objects (x,y are even)
-    struct Wall
+    constexpr int WALL_HEALTH = 2;
+
+    // What a tank did in the current step, formatted into the moves file only when verbose
+    struct TankMoveRecord
     {
-        int x;
-        int y;
-        short health;
+        ActionRequest action{ActionRequest::DoNothing};
+        bool recorded{false}; // nothing to report before the tank's first move
+        bool ignored{false};
+        bool killed{false}; // killed during this step
+        bool dead{false};   // killed in an earlier step
     };
 
     class Tank;
     class Shell;
 
-    class GameManager : public AbstractGameManager
+    class GameManager : public AbstractGameManager, public UC::BatchGameManager, public UC::ReplayRecorder,
+                        public UC::FrameFormatSelector, public UC::BudgetedGameManager,
+                        public UC::VerboseOutputReporter
     {
     private:
         int width{};
@@ -38,27 +53,65 @@ namespace GameManager_212788293_212497127
         int numShellsPerTank{};
         int totalTanks{};
 
-        std::vector<std::string> movesOfTanks;
+        std::vector<TankMoveRecord> movesOfTanks;
         std::unordered_map<int, int> playerTanksCount;
 
-        // keyed by bijection(x,y) on doubled grid
-        std::map<int, std::unique_ptr<Tank>> tanks;
-        std::unordered_map<int, std::unique_ptr<Shell>> shells;
-        std::set<int> mines;
-        std::unordered_map<int, Wall> walls;
-
-        std::set<int> wallsToRemove;
-        std::set<int> tanksToRemove;
-        std::set<int> shellsToRemove;
-
-        // staging maps for movement steps
-        std::unordered_map<int, std::unique_ptr<Shell>> secondaryShells;
-        std::map<int, std::unique_ptr<Tank>> secondaryTanks;
-        std::unordered_set<int> shellsFired;
+        // walls, mines and the occupancy of tanks/shells on the doubled grid
+        Board board;
+
+        // tanks are indexed by their global id, shells by pool slot (freed slots are reused)
+        EntityStore entities;
+
+        // cells reached by a shell / tank during the current movement sub-step
+        StampGrid shellArrivals;
+        StampGrid tankArrivals;
+
+        // board cell indices queued for removal
+        std::vector<int> wallsToRemove;
+        std::vector<int> tanksToRemove;
+        std::vector<int> shellsToRemove;
+
+        // Cantor-paired positions of the shells fired in the last step, in the order they were
+        // first recorded; a position stays listed until the next advanceShellsRecentlyFired()
+        std::vector<int> shellsFired;
+
+        // live tanks by the Cantor pairing of their position, the order they are played in
+        std::vector<int> tankOrder;
+
+        // players of the game in progress, battle info requests are routed to them
+        Player *player1{};
+        Player *player2{};
+
+        int stepsWithoutShells{};
+        int winner{};
+        GameResult::Reason endReason{GameResult::ALL_TANKS_DEAD};
+
+        // time limits; a game over budget ends after the round in progress
+        UC::GameBudget budget;
+        std::shared_ptr<const UC::CancellationToken> cancellation;
+        // time this game has spent in its own startGame and rounds
+        std::chrono::steady_clock::duration playTime{};
+        int overrunPlayers{}; // bit p set once a call of player p overran budget.tankCall
+        UC::Timeout timeout{UC::Timeout::None};
+        std::vector<UC::Timeout> lastTimeouts; // per game of the last run / runBatch
+        std::vector<std::chrono::steady_clock::duration> lastPlayTimes;
+
+        // satellite symbols and visualization of the current round, one char per map cell
+        // (row-major). Both are kept between rounds and only the cells the board marked dirty
+        // are recomputed; the frame is only maintained when it is written out.
+        std::vector<char> satellite;
+        std::vector<char> frame;
+        std::vector<int> frameChanges; // cells whose symbol changed in the last updateViews()
+        UC::FrameFormat frameFormat{UC::FrameFormat::Full};
+
+        // binary replay, recorded when a replay directory is set
+        std::string replayDir;
+        ReplayWriter replay;
+        std::vector<std::uint8_t> requestedMoves;
 
         bool verbose{false};
-        std::ofstream moves_out;
-        std::ofstream viz_out;
+        AsyncFileWriter moves_out;
+        AsyncFileWriter viz_out;
         std::string verbose_dir{"verbose"};
         std::string visualization_dir{"visualization"};
 
@@ -68,13 +121,14 @@ namespace GameManager_212788293_212497127
 
         int getWidth() { return width; }
         int getHeight() { return height; }
-        int bijection(int x, int y);
 
-        std::unordered_map<int, Wall> &getWalls() { return walls; }
+        Board &getBoard() { return board; }
+        EntityStore &getEntities() { return entities; }
 
         void removeTank(int tankPos);
         void removeShell(int shellPos);
-        void addShell(std::unique_ptr<Shell> shell);
+        EntityHandle spawnShell(int x, int y, UC::Direction dir);
+        void addShell(EntityHandle shell);
 
         int readMap(size_t width, size_t height, const SatelliteView &map);
 
@@ -87,17 +141,48 @@ namespace GameManager_212788293_212497127
             TankAlgorithmFactory player1_tank_algo_factory,
             TankAlgorithmFactory player2_tank_algo_factory) override;
 
+        void runBatch(size_t map_width, size_t map_height, std::vector<UC::BatchGame> &games,
+                      const GameFinished &finished) override;
+
+        void setReplayDirectory(const std::string &dir) override;
+        void setFrameFormat(UC::FrameFormat format) override;
+        void setBudget(const UC::GameBudget &budget, std::shared_ptr<const UC::CancellationToken> token) override;
+        UC::Timeout getTimeout(size_t game) const override;
+        std::chrono::duration<double> getPlayTime(size_t game) const override;
+        UC::VerboseOutputStats getVerboseOutputStats() const override;
+
+        // Lookahead / resume: a snapshot holds the whole engine state between two rounds, with the
+        // time played and any budget overrun so far. Players, tank algorithms, the budget and the
+        // cancellation token are not part of it; restore() keeps the attached ones,
+        // a fork() starts with none and needs attachPlayers() before playStep().
+        GameSnapshot snapshot() const;
+        void restore(const GameSnapshot &snapshot);
+        std::unique_ptr<GameManager> fork() const;
+        void attachPlayers(Player &player1, Player &player2,
+                           TankAlgorithmFactory &player1_tank_algo_factory,
+                           TankAlgorithmFactory &player2_tank_algo_factory);
+
+        // A game can also be driven round by round: startGame() (false when it ended before
+        // round 0), playStep() until it returns true, then collectResult().
+        bool startGame(size_t map_width, size_t map_height,
+                       const SatelliteView &map,
+                       const string &map_name,
+                       size_t max_steps, size_t num_shells,
+                       Player &player1, const string &name1, Player &player2, const string &name2,
+                       TankAlgorithmFactory &player1_tank_algo_factory,
+                       TankAlgorithmFactory &player2_tank_algo_factory);
+        // plays one round, returns true once the game is over
+        bool playStep();
+        GameResult collectResult(bool played);
+
     private:
+
         int getGameStep() { return gameStep; }
         int getWallHealth(int wallPos);
 
-        std::map<int, std::unique_ptr<Tank>> &getTanks() { return tanks; }
-        std::unordered_map<int, std::unique_ptr<Shell>> &getShells() { return shells; }
-        std::set<int> &getMines() { return mines; }
-
         void getPlayersInput(std::ofstream &file);
         void incrementGameStep();
-        void addTank(std::unique_ptr<Tank> tank);
+        void addTank(int x, int y, UC::Direction dir, int playerId, int tankId);
 
         void addMine(int x, int y);
         void addWall(int x, int y);
@@ -108,11 +193,17 @@ namespace GameManager_212788293_212497127
         void removeTanks();
         void removeShells();
         void removeWalls();
+        void destroyShell(int shellIndex);
+        const std::vector<int> &tanksInPositionOrder();
+        void recordMove(int tankIndex, ActionRequest move, bool ignored = false);
 
         void hitWall(int x, int y);
-        void hitTank(int tankId);
 
         void checkForAMine(int x, int y);
+        char satelliteSymbol(int cell) const;
+        char frameSymbol(int cell) const;
+        void renderFrame();
+        void updateViews();
         void printBoard();
 
         void advanceShells();
@@ -125,17 +216,22 @@ namespace GameManager_212788293_212497127
         void tankShootingShells(Tank &tank);
         void rotate(Tank &tank);
         void checkForTankCollision(Tank &tank);
-        void checkForShellCollision(Shell &shell);
+        void checkForShellCollision(int shellIndex);
         void tankHitByAShell(int tankPos);
         void shellHitAWall(int shellPos);
 
+        void chargeTankCall(int playerId, std::chrono::steady_clock::time_point start);
+        bool outOfBudget();
+
         bool checkForAWinner();
         std::optional<int> winnerByTanks() const;
 
         std::vector<std::string> splitByComma(const std::string &input);
-        void sortTanks();
         void outputTankMoves();
-        void openVerboseFiles(const std::string &gmName, const std::string &mapName, const std::string &alg1Name, const std::string &alg2Name);
+        void openVerboseFiles(const std::string &base);
+        void openReplay(const std::string &base, const std::string &mapName, const std::string &alg1Name, const std::string &alg2Name);
+        void recordReplayMoves();
+        void recordReplayFrame();
 
         void clearGameState();
 
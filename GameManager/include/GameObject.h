@@ -9,16 +9,18 @@ namespace GameManager_212788293_212497127
 {
     class GameManager; // Forward declaration
     // ========================= CLASS: GameObject =========================
+    // Lightweight view over a row of an entity store, position and direction
+    // are references into the store columns.
     class GameObject
     {
     protected:
-        int x;
-        int y;
-        UC::Direction direction;
+        int &x;
+        int &y;
+        UC::Direction &direction;
         GameManager_212788293_212497127::GameManager* game;
 
     public:
-        GameObject(int x, int y, UC::Direction dir, GameManager* game);
+        GameObject(int &x, int &y, UC::Direction &dir, GameManager* game);
         int getX();
         int getY();
         virtual ~GameObject() = default;
@@ -28,4 +30,4 @@ namespace GameManager_212788293_212497127
         bool moveForward();
         void updatePosition(UC::Direction dir);
     };
-}
\ No newline at end of file
+}
@@ -1,34 +1,33 @@
 #pragma once
 #include "common/SatelliteView.h"
-#include "UserCommon/DirectionUtils.h"
-#include "Tank.h"
-#include "Shell.h"
-#include "GameManager.h"
-#include <unordered_map>
-#include <map>
-#include <set>
+#include "UserCommon/BulkSatelliteView.h"
 #include <cstddef>
+#include <vector>
 
 namespace UC = UserCommon_212788293_212497127;
 
 namespace GameManager_212788293_212497127
 {
-    class MySatelliteView : public SatelliteView
+    // ========================= CLASS: MySatelliteView =========================
+    // Satellite image over the GameManager's per-cell symbol grid (row-major, width*height).
+    // A view handed to a tank borrows the grid and shows the tank's own cell as '%';
+    // the final game state owns a copy of it.
+
+    class MySatelliteView : public SatelliteView, public UC::BulkSatelliteView
     {
     private:
-        int tankPos;
-        const std::map<int, std::unique_ptr<Tank>> &tanks;
-        const std::unordered_map<int, std::unique_ptr<Shell>> &shells;
-        const std::set<int> &mines;
-        const std::unordered_map<int, Wall> &walls;
+        std::vector<char> owned;
+        const char *cells;
+        size_t width;
+        size_t height;
+        size_t self; // cell shown as '%', or out of range
 
     public:
-        MySatelliteView(int tankPos,
-                        const std::map<int, std::unique_ptr<Tank>> &tanks,
-                        const std::unordered_map<int, std::unique_ptr<Shell>> &shells,
-                        const std::set<int> &mines,
-                        const std::unordered_map<int, Wall> &walls);
+        MySatelliteView(const char *cells, size_t width, size_t height, int selfCell = -1);
+        MySatelliteView(std::vector<char> grid, size_t width, size_t height);
 
         char getObjectAt(size_t x, size_t y) const override;
+        void copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const override;
+        UC::SatelliteSpan span() const override;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/GameResult.h"
+#include "UserCommon/Replay.h"
+
+namespace GameManager_212788293_212497127
+{
+    struct ReplayHeader
+    {
+        int width{};
+        int height{};
+        int maxSteps{};
+        int numShells{};
+        int tankCount{};
+        std::string gameManager;
+        std::string mapName;
+        std::string player1;
+        std::string player2;
+    };
+
+    // ========================= CLASS: ReplayWriter =========================
+    // Streams a game into the binary replay format (see UserCommon/Replay.h). Records are
+    // collected in a buffer that is written to the file in large chunks.
+
+    class ReplayWriter
+    {
+    private:
+        std::ofstream out;
+        std::vector<std::uint8_t> buffer;
+        size_t frameCells{};
+        int framesSinceKeyFrame{};
+
+        void putString(const std::string &value);
+        void flush();
+
+    public:
+        bool open(const std::string &path, const ReplayHeader &header, const std::vector<char> &initialFrame);
+        bool isOpen() const { return out.is_open(); }
+
+        void beginStep(int step);
+        void addTank(std::uint8_t requested, std::uint8_t outcome);
+        // changedCells lists the cells of `frame` that differ from the frame of the previous step
+        void addFrame(const std::vector<char> &frame, const std::vector<int> &changedCells);
+
+        // writes the end record and closes the file
+        void finish(const GameResult &result);
+        void close();
+    };
+}
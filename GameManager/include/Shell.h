@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameObject.h"
+#include "EntityStore.h"
 
 namespace GameManager_212788293_212497127
 {
@@ -9,7 +10,7 @@ namespace GameManager_212788293_212497127
     class Shell : public GameObject
     {
     public:
-        Shell(int x, int y, UC::Direction dir, GameManager* game);
+        Shell(ShellStore &store, int index, GameManager* game);
         bool checkForAWall();
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace GameManager_212788293_212497127
+{
+    // what restore() throws for a snapshot it cannot use
+    [[noreturn]] inline void corruptSnapshot(const char *what)
+    {
+        throw std::runtime_error(std::string("GameSnapshot: ") + what);
+    }
+
+    // ========================= CLASS: GameSnapshot =========================
+    // Immutable flat blob holding the complete state of a game in progress. Copies share the
+    // blob, so handing snapshots around never copies the bytes.
+
+    class GameSnapshot
+    {
+    private:
+        std::shared_ptr<const std::vector<std::uint8_t>> blob;
+
+    public:
+        GameSnapshot() = default;
+        explicit GameSnapshot(std::vector<std::uint8_t> bytes)
+            : blob(std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes))) {}
+
+        // rebuild a snapshot from bytes previously obtained through data()/size(), e.g. read from disk
+        static GameSnapshot fromBytes(const std::uint8_t *bytes, size_t size)
+        {
+            return GameSnapshot(std::vector<std::uint8_t>(bytes, bytes + size));
+        }
+
+        bool empty() const { return !blob || blob->empty(); }
+        const std::uint8_t *data() const { return blob ? blob->data() : nullptr; }
+        size_t size() const { return blob ? blob->size() : 0; }
+    };
+
+    // ========================= CLASS: SnapshotWriter =========================
+
+    class SnapshotWriter
+    {
+    private:
+        std::vector<std::uint8_t> &out;
+
+    public:
+        explicit SnapshotWriter(std::vector<std::uint8_t> &out) : out(out) {}
+
+        template <typename T>
+        void put(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void putVector(const std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            put(static_cast<std::uint32_t>(values.size()));
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(values.data());
+            out.insert(out.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+    };
+
+    // ========================= CLASS: SnapshotReader =========================
+
+    class SnapshotReader
+    {
+    private:
+        const std::uint8_t *cur;
+        const std::uint8_t *end;
+
+        void require(size_t bytes) const
+        {
+            if (remaining() < bytes)
+                corruptSnapshot("truncated or corrupt snapshot");
+        }
+
+    public:
+        explicit SnapshotReader(const GameSnapshot &snapshot)
+            : cur(snapshot.data()), end(snapshot.data() + snapshot.size()) {}
+
+        size_t remaining() const { return static_cast<size_t>(end - cur); }
+
+        template <typename T>
+        T get()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, cur, sizeof(T));
+            cur += sizeof(T);
+            return value;
+        }
+
+        template <typename T>
+        void getVector(std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            size_t count = get<std::uint32_t>();
+            require(count * sizeof(T));
+            values.resize(count);
+            if (count > 0)
+                std::memcpy(values.data(), cur, count * sizeof(T));
+            cur += count * sizeof(T);
+        }
+    };
+}
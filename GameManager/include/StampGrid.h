@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GameManager_212788293_212497127
+{
+    // ========================= CLASS: StampGrid =========================
+    // Per-cell scratch values tagged with an epoch. Starting a new epoch invalidates every
+    // cell at once, so the grid never has to be cleared between movement sub-steps.
+
+    class StampGrid
+    {
+    private:
+        std::uint32_t epoch{0};
+        std::vector<std::uint32_t> stamps;
+        std::vector<std::int32_t> values;
+
+    public:
+        void reset(int cellCount);
+        void nextEpoch();
+
+        // value written to the cell during the current epoch, -1 if none
+        int get(int idx) const { return stamps[idx] == epoch ? values[idx] : -1; }
+        void set(int idx, int value)
+        {
+            stamps[idx] = epoch;
+            values[idx] = value;
+        }
+    };
+}
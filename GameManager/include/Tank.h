@@ -4,30 +4,23 @@
 #include <set>
 #include "GameObject.h"
 #include "GameManager.h"
+#include "EntityStore.h"
 #include "common/TankAlgorithm.h"
 
 namespace GameManager_212788293_212497127
 {
     class GameManager;
     // ========================= CLASS: Tank =========================
+    // View over row `index` of the TankStore (the row index is the tank global id).
 
     class Tank : public GameObject
     {
     private:
-        int playerId;
-        int artilleryShells;
-        int tankId;
-        int tankGlobalId;
-        bool destroyed;
-        int cantShoot;
-        int reverseCharge = 0;
-        bool reverseQueued = false;
-        bool reverseReady = false;
-        std::unique_ptr<TankAlgorithm> tankAlgorithm;
-        ActionRequest lastMove;
+        TankStore &store;
+        int index;
 
     public:
-        Tank(int x, int y, UC::Direction dir, GameManager* game, int playerId, int shells, int tankId, int tankGlobalId);
+        Tank(TankStore &store, int index, GameManager* game);
 
         // Position and state
         int getPlayerId();
@@ -38,7 +31,7 @@ namespace GameManager_212788293_212497127
 
         // Movement
         void moveBackwards();
-        void rotateTank(double angle);
+        void rotateTank(int eighths); // eighths of a full turn, > 0 turns right
         void setDirection(std::string directionStr);
         void setLastMove(ActionRequest currentMove);
         TankAlgorithm *getTankAlgorithm();
@@ -66,4 +59,4 @@ namespace GameManager_212788293_212497127
         void executeReverse();
         void ignoreMove();
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,225 @@
+#include "AsyncFileSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace GameManager_212788293_212497127
+{
+    namespace
+    {
+        constexpr size_t FILE_BUFFER_SIZE = 1 << 20;
+        constexpr auto IDLE_WAKEUP = std::chrono::milliseconds(5);
+        constexpr auto STALL_BACKOFF = std::chrono::microseconds(50);
+    }
+
+    // ------------------------ AsyncFileSink ------------------------
+
+    AsyncFileSink &AsyncFileSink::instance()
+    {
+        static AsyncFileSink sink;
+        return sink;
+    }
+
+    AsyncFileSink::~AsyncFileSink()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work.notify_all();
+        if (writer.joinable())
+            writer.join();
+    }
+
+    std::shared_ptr<AsyncChannel> AsyncFileSink::open(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return nullptr;
+        std::setvbuf(file, nullptr, _IOFBF, FILE_BUFFER_SIZE);
+
+        auto channel = std::make_shared<AsyncChannel>();
+        channel->file = file;
+        channel->capacity = RING_CAPACITY;
+        channel->ring = std::make_unique<char[]>(RING_CAPACITY);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        channels.push_back(channel);
+        if (!writer.joinable())
+            writer = std::thread(&AsyncFileSink::run, this);
+        return channel;
+    }
+
+    void AsyncFileSink::push(AsyncChannel &channel, const char *data, size_t size)
+    {
+        const size_t mask = channel.capacity - 1;
+        while (size > 0)
+        {
+            size_t head = channel.head.load(std::memory_order_relaxed);
+            size_t room = channel.capacity - (head - channel.tail.load(std::memory_order_acquire));
+            if (room == 0)
+            {
+                // backpressure: the writer is behind, wait for it instead of growing memory
+                auto start = std::chrono::steady_clock::now();
+                producerStalls.fetch_add(1, std::memory_order_relaxed);
+                wake();
+                std::this_thread::sleep_for(STALL_BACKOFF);
+                auto waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                stallMicroseconds.fetch_add(static_cast<std::uint64_t>(waited.count()), std::memory_order_relaxed);
+                continue;
+            }
+
+            size_t offset = head & mask;
+            size_t chunk = std::min({size, room, channel.capacity - offset});
+            std::memcpy(channel.ring.get() + offset, data, chunk);
+            channel.head.store(head + chunk, std::memory_order_release);
+            data += chunk;
+            size -= chunk;
+
+            // do not wait for the idle wake-up once the ring is half full
+            if ((head + chunk) - channel.tail.load(std::memory_order_relaxed) >= channel.capacity / 2)
+                wake();
+        }
+    }
+
+    void AsyncFileSink::close(const std::shared_ptr<AsyncChannel> &channel)
+    {
+        channel->closed.store(true, std::memory_order_release);
+        wake();
+    }
+
+    void AsyncFileSink::wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingWork = true;
+        }
+        work.notify_one();
+    }
+
+    void AsyncFileSink::drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!writer.joinable())
+            return;
+        // two full passes guarantee that bytes pushed before this call have been written
+        std::uint64_t target = passes + 2;
+        pendingWork = true;
+        work.notify_one();
+        idle.wait(lock, [&] { return passes >= target || stopping; });
+    }
+
+    AsyncSinkStats AsyncFileSink::stats() const
+    {
+        AsyncSinkStats result;
+        result.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+        result.writeCalls = writeCalls.load(std::memory_order_relaxed);
+        result.producerStalls = producerStalls.load(std::memory_order_relaxed);
+        result.stallMicroseconds = stallMicroseconds.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    bool AsyncFileSink::drainChannel(AsyncChannel &channel)
+    {
+        // read `closed` first: once it is set the producer has pushed its last byte
+        bool closing = channel.closed.load(std::memory_order_acquire);
+        const size_t mask = channel.capacity - 1;
+        size_t tail = channel.tail.load(std::memory_order_relaxed);
+        size_t head = channel.head.load(std::memory_order_acquire);
+        while (tail != head)
+        {
+            size_t offset = tail & mask;
+            size_t chunk = std::min(head - tail, channel.capacity - offset);
+            std::fwrite(channel.ring.get() + offset, 1, chunk, channel.file);
+            bytesWritten.fetch_add(chunk, std::memory_order_relaxed);
+            writeCalls.fetch_add(1, std::memory_order_relaxed);
+            tail += chunk;
+        }
+        channel.tail.store(tail, std::memory_order_release);
+
+        if (!closing)
+            return false;
+        std::fclose(channel.file);
+        channel.file = nullptr;
+        return true;
+    }
+
+    void AsyncFileSink::run()
+    {
+        std::vector<std::shared_ptr<AsyncChannel>> snapshot;
+        while (true)
+        {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work.wait_for(lock, IDLE_WAKEUP, [&] { return pendingWork || stopping; });
+                pendingWork = false;
+                stop = stopping;
+                snapshot = channels;
+            }
+
+            std::vector<AsyncChannel *> finished;
+            for (const auto &channel : snapshot)
+            {
+                if (drainChannel(*channel))
+                    finished.push_back(channel.get());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!finished.empty())
+                {
+                    channels.erase(std::remove_if(channels.begin(), channels.end(),
+                                                  [&](const std::shared_ptr<AsyncChannel> &c)
+                                                  { return std::find(finished.begin(), finished.end(), c.get()) != finished.end(); }),
+                                   channels.end());
+                }
+                ++passes;
+            }
+            idle.notify_all();
+            snapshot.clear();
+
+            if (stop)
+                break;
+        }
+
+        // flush whatever is left of files that were never closed
+        for (const auto &channel : channels)
+        {
+            drainChannel(*channel);
+            if (channel->file)
+            {
+                std::fclose(channel->file);
+                channel->file = nullptr;
+            }
+        }
+        channels.clear();
+    }
+
+    // ------------------------ AsyncFileWriter ------------------------
+
+    bool AsyncFileWriter::open(const std::string &path)
+    {
+        close();
+        channel = AsyncFileSink::instance().open(path);
+        return channel != nullptr;
+    }
+
+    void AsyncFileWriter::flush()
+    {
+        if (!channel || staged.empty())
+            return;
+        AsyncFileSink::instance().push(*channel, staged.data(), staged.size());
+        staged.clear();
+    }
+
+    void AsyncFileWriter::close()
+    {
+        if (!channel)
+            return;
+        flush();
+        AsyncFileSink::instance().close(channel);
+        channel.reset();
+    }
+}
@@ -0,0 +1,125 @@
+#include "Board.h"
+
+namespace GameManager_212788293_212497127
+{
+    // ------------------------ Board ------------------------
+
+    void Board::reset(int doubledWidth, int doubledHeight)
+    {
+        width = doubledWidth;
+        height = doubledHeight;
+        grid = UC::GridIndex(width, height);
+        mapGrid = UC::GridIndex(width / 2, height / 2);
+        // assign() keeps the capacity, so a GameManager reused across games does not reallocate
+        cells.assign(static_cast<size_t>(width) * static_cast<size_t>(height), Cell{});
+        dirtyFlags.assign(static_cast<size_t>(mapGrid.size()), 0);
+        dirtyCells.clear();
+    }
+
+    void Board::clearDirty()
+    {
+        for (int cell : dirtyCells)
+            dirtyFlags[cell] = 0;
+        dirtyCells.clear();
+    }
+
+    void Board::addWall(int idx, std::int8_t health)
+    {
+        cells[idx].kind |= WallCell;
+        cells[idx].health = health;
+        markDirty(idx);
+    }
+
+    int Board::damageWall(int idx)
+    {
+        markDirty(idx);
+        return --cells[idx].health;
+    }
+
+    void Board::removeWall(int idx)
+    {
+        cells[idx].kind &= ~WallCell;
+        cells[idx].health = 0;
+        markDirty(idx);
+    }
+
+    void Board::addMine(int idx)
+    {
+        cells[idx].kind |= MineCell;
+        markDirty(idx);
+    }
+
+    void Board::removeMine(int idx)
+    {
+        cells[idx].kind &= ~MineCell;
+        markDirty(idx);
+    }
+
+    void Board::placeTank(int idx, int tank, int owner)
+    {
+        cells[idx].kind |= TankCell;
+        cells[idx].tank = tank;
+        cells[idx].owner = static_cast<std::uint8_t>(owner);
+        markDirty(idx);
+    }
+
+    void Board::clearTank(int idx)
+    {
+        cells[idx].kind &= ~TankCell;
+        cells[idx].tank = -1;
+        cells[idx].owner = 0;
+        markDirty(idx);
+    }
+
+    void Board::placeShell(int idx, int shell)
+    {
+        cells[idx].kind |= ShellCell;
+        cells[idx].shell = shell;
+        markDirty(idx);
+    }
+
+    void Board::clearShell(int idx)
+    {
+        cells[idx].kind &= ~ShellCell;
+        cells[idx].shell = -1;
+        markDirty(idx);
+    }
+
+    void Board::save(SnapshotWriter &out) const
+    {
+        out.put(static_cast<std::int32_t>(width));
+        out.put(static_cast<std::int32_t>(height));
+        // walls and mines only ever sit on even cells of the doubled grid
+        for (int y = 0; y < height; y += 2)
+        {
+            for (int x = 0; x < width; x += 2)
+            {
+                const Cell &cell = cells[index(x, y)];
+                out.put(static_cast<std::uint8_t>(cell.kind & (WallCell | MineCell)));
+                out.put(cell.health);
+            }
+        }
+    }
+
+    void Board::load(SnapshotReader &in)
+    {
+        const int doubledWidth = in.get<std::int32_t>();
+        const int doubledHeight = in.get<std::int32_t>();
+        // the size is checked against the bytes that must follow before anything is allocated
+        if (doubledWidth <= 0 || doubledHeight <= 0 || doubledWidth % 2 != 0 || doubledHeight % 2 != 0 ||
+            static_cast<std::uint64_t>(doubledWidth / 2) * static_cast<std::uint64_t>(doubledHeight / 2) * 2 > in.remaining())
+            corruptSnapshot("bad board size");
+        reset(doubledWidth, doubledHeight);
+        for (int y = 0; y < height; y += 2)
+        {
+            for (int x = 0; x < width; x += 2)
+            {
+                Cell &cell = cells[index(x, y)];
+                cell.kind = in.get<std::uint8_t>();
+                cell.health = in.get<std::int8_t>();
+                if (cell.kind & ~(WallCell | MineCell))
+                    corruptSnapshot("bad board cell");
+            }
+        }
+    }
+}
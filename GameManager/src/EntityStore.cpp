@@ -0,0 +1,204 @@
+#include <cstring>
+#include <type_traits>
+#include "EntityStore.h"
+
+namespace GameManager_212788293_212497127
+{
+    namespace
+    {
+        // read through the bytes: loading an out-of-range value as a Direction is undefined
+        bool validDirection(const UC::Direction &dir)
+        {
+            std::underlying_type_t<UC::Direction> raw;
+            std::memcpy(&raw, &dir, sizeof(raw));
+            return raw >= UC::U && raw <= UC::UL;
+        }
+    }
+
+    // ------------------------ TankStore ------------------------
+
+    int TankStore::add(int tx, int ty, UC::Direction dir, int player, int shells, int id)
+    {
+        x.push_back(tx);
+        y.push_back(ty);
+        direction.push_back(dir);
+        playerId.push_back(player);
+        tankId.push_back(id);
+        artilleryShells.push_back(shells);
+        cantShoot.push_back(0);
+        reverseCharge.push_back(0);
+        reverseQueued.push_back(false);
+        reverseReady.push_back(false);
+        alive.push_back(true);
+        lastMove.push_back(ActionRequest::DoNothing);
+        algorithms.emplace_back();
+        return size() - 1;
+    }
+
+    void TankStore::kill(int index)
+    {
+        alive[index] = false;
+        algorithms[index].reset();
+    }
+
+    void TankStore::clear()
+    {
+        // clear() keeps the capacity of every column for the next game
+        x.clear();
+        y.clear();
+        direction.clear();
+        playerId.clear();
+        tankId.clear();
+        artilleryShells.clear();
+        cantShoot.clear();
+        reverseCharge.clear();
+        reverseQueued.clear();
+        reverseReady.clear();
+        alive.clear();
+        lastMove.clear();
+        algorithms.clear();
+    }
+
+    void TankStore::save(SnapshotWriter &out) const
+    {
+        out.putVector(x);
+        out.putVector(y);
+        out.putVector(direction);
+        out.putVector(playerId);
+        out.putVector(tankId);
+        out.putVector(artilleryShells);
+        out.putVector(cantShoot);
+        out.putVector(reverseCharge);
+        out.putVector(reverseQueued);
+        out.putVector(reverseReady);
+        out.putVector(alive);
+        out.putVector(lastMove);
+    }
+
+    void TankStore::load(SnapshotReader &in)
+    {
+        in.getVector(x);
+        in.getVector(y);
+        in.getVector(direction);
+        in.getVector(playerId);
+        in.getVector(tankId);
+        in.getVector(artilleryShells);
+        in.getVector(cantShoot);
+        in.getVector(reverseCharge);
+        in.getVector(reverseQueued);
+        in.getVector(reverseReady);
+        in.getVector(alive);
+        in.getVector(lastMove);
+
+        const size_t count = alive.size();
+        for (size_t column : {x.size(), y.size(), direction.size(), playerId.size(), tankId.size(), artilleryShells.size(),
+                              cantShoot.size(), reverseCharge.size(), reverseQueued.size(), reverseReady.size(), lastMove.size()})
+        {
+            if (column != count)
+                corruptSnapshot("tank columns differ in length");
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!validDirection(direction[i]) || (playerId[i] != 1 && playerId[i] != 2) ||
+                static_cast<int>(lastMove[i]) < 0 || lastMove[i] > ActionRequest::DoNothing)
+                corruptSnapshot("bad tank");
+        }
+        algorithms.clear();
+        algorithms.resize(count);
+    }
+
+    // ------------------------ ShellStore ------------------------
+
+    EntityHandle ShellStore::spawn(int sx, int sy, UC::Direction dir, int step)
+    {
+        int index;
+        if (!freeSlots.empty())
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+            x[index] = sx;
+            y[index] = sy;
+            direction[index] = dir;
+            firedAt[index] = step;
+            alive[index] = true;
+        }
+        else
+        {
+            index = size();
+            x.push_back(sx);
+            y.push_back(sy);
+            direction.push_back(dir);
+            firedAt.push_back(step);
+            generation.push_back(0);
+            alive.push_back(true);
+        }
+        return {index, generation[index]};
+    }
+
+    void ShellStore::release(int index)
+    {
+        alive[index] = false;
+        ++generation[index];
+        freeSlots.push_back(index);
+    }
+
+    bool ShellStore::isValid(EntityHandle handle) const
+    {
+        return handle.index >= 0 && handle.index < size() &&
+               alive[handle.index] && generation[handle.index] == handle.generation;
+    }
+
+    void ShellStore::clear()
+    {
+        x.clear();
+        y.clear();
+        direction.clear();
+        firedAt.clear();
+        generation.clear();
+        alive.clear();
+        freeSlots.clear();
+    }
+
+    void ShellStore::save(SnapshotWriter &out) const
+    {
+        // every slot and the free list are kept, slot order decides the order shells move in
+        out.putVector(x);
+        out.putVector(y);
+        out.putVector(direction);
+        out.putVector(firedAt);
+        out.putVector(generation);
+        out.putVector(alive);
+        out.putVector(freeSlots);
+    }
+
+    void ShellStore::load(SnapshotReader &in)
+    {
+        in.getVector(x);
+        in.getVector(y);
+        in.getVector(direction);
+        in.getVector(firedAt);
+        in.getVector(generation);
+        in.getVector(alive);
+        in.getVector(freeSlots);
+
+        const size_t count = alive.size();
+        for (size_t column : {x.size(), y.size(), direction.size(), firedAt.size(), generation.size()})
+        {
+            if (column != count)
+                corruptSnapshot("shell columns differ in length");
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!validDirection(direction[i]))
+                corruptSnapshot("bad shell");
+        }
+        // a slot listed twice, or a live one, would be handed out to two shells
+        std::vector<std::uint8_t> listed(count, 0);
+        for (int slot : freeSlots)
+        {
+            if (slot < 0 || static_cast<size_t>(slot) >= count || alive[slot] || listed[slot])
+                corruptSnapshot("bad shell free list");
+            listed[slot] = 1;
+        }
+    }
+}
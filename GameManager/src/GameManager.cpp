@@ -3,13 +3,18 @@
 #include <cmath>
 #include <chrono>
 #include <cctype>
+#include <cstring>
 #include <filesystem>
 #include <sstream>
+#include <stdexcept>
+#include <unordered_set>
 #include <utility>
 #include "common/GameManagerRegistration.h"
 
 #include "GameManager.h"
 #include "MySatelliteView.h"
+#include "Tank.h"
+#include "Shell.h"
 
 namespace
 {
@@ -17,6 +22,24 @@ namespace
 
     std::atomic<uint64_t> g_run_counter{0};
 
+    // Cantor pairing of a position, the key tanks and recently fired shells are ordered by
+    int cantorKey(int x, int y)
+    {
+        return ((x + y) * (x + y + 1)) / 2 + y;
+    }
+
+    // inverse of cantorKey
+    std::pair<int, int> unpair(int key)
+    {
+        long long w = static_cast<long long>((std::sqrt(8.0 * key + 1) - 1) / 2);
+        while ((w + 1) * (w + 2) / 2 <= key)
+            ++w;
+        while (w * (w + 1) / 2 > key)
+            --w;
+        const long long y = key - w * (w + 1) / 2;
+        return {static_cast<int>(w - y), static_cast<int>(y)};
+    }
+
     static std::string sanitize(std::string s)
     {
         for (char &c : s)
@@ -44,6 +67,7 @@ namespace
 namespace GameManager_212788293_212497127
 {
     constexpr int MAX_STEPS_WITHOUT_SHELLS = 40;
+    constexpr std::uint32_t SNAPSHOT_VERSION = 3;
 
     REGISTER_GAME_MANAGER(GameManager);
     // ------------------------ GameManager ------------------------
@@ -63,60 +87,114 @@ namespace GameManager_212788293_212497127
 
     int GameManager::getWallHealth(int wallPos)
     {
-        return walls[wallPos].health;
+        return board.at(wallPos).health;
     }
 
     void GameManager::incrementGameStep() { gameStep++; }
 
-    void GameManager::addTank(std::unique_ptr<Tank> tank)
+    void GameManager::addTank(int x, int y, UC::Direction dir, int playerId, int tankId)
+    {
+        int id = entities.tanks.add(x, y, dir, playerId, numShellsPerTank, tankId);
+        board.placeTank(board.index(x, y), id, playerId);
+    }
+
+    EntityHandle GameManager::spawnShell(int x, int y, UC::Direction dir)
     {
-        tanks[bijection(tank->getX(), tank->getY())] = std::move(tank);
+        return entities.shells.spawn(x, y, dir, gameStep);
     }
 
-    void GameManager::addShell(std::unique_ptr<Shell> shell)
+    void GameManager::addShell(EntityHandle shell)
     {
-        int newPos = UC::bijection(shell->getX(), shell->getY());
+        ShellStore &shells = entities.shells;
+        int newPos = board.index(shells.x[shell.index], shells.y[shell.index]);
+        const int key = cantorKey(shells.x[shell.index], shells.y[shell.index]);
+
+        // a shell already in the cell is replaced; firing onto a recently fired shell collides
+        if (std::find(shellsFired.begin(), shellsFired.end(), key) != shellsFired.end())
+            shellsToRemove.push_back(newPos);
+        else
+            shellsFired.push_back(key);
+        int existing = board.shellAt(newPos);
+        if (existing >= 0)
+            destroyShell(existing);
 
-        if (shellsFired.count(newPos))
+        board.placeShell(newPos, shell.index);
+    }
+
+    const std::vector<int> &GameManager::tanksInPositionOrder()
+    {
+        const TankStore &tanks = entities.tanks;
+        tankOrder.clear();
+        for (int i = 0; i < tanks.size(); ++i)
         {
-            shellsToRemove.insert(newPos);
+            if (tanks.alive[i])
+                tankOrder.push_back(i);
         }
+        std::sort(tankOrder.begin(), tankOrder.end(), [&tanks](int a, int b)
+                  { return std::make_pair(cantorKey(tanks.x[a], tanks.y[a]), a) < std::make_pair(cantorKey(tanks.x[b], tanks.y[b]), b); });
+        return tankOrder;
+    }
 
-        shellsFired.insert(newPos);
-        shells[newPos] = std::move(shell);
+    void GameManager::destroyShell(int shellIndex)
+    {
+        entities.shells.release(shellIndex);
+    }
+
+    void GameManager::recordMove(int tankIndex, ActionRequest move, bool ignored)
+    {
+        TankMoveRecord &record = movesOfTanks[tankIndex];
+        record.action = move;
+        record.recorded = true;
+        record.ignored = ignored;
+        record.killed = false;
     }
 
     void GameManager::advanceShellsRecentlyFired()
     {
-        std::unordered_set<int> newFired;
+        if (shellsFired.empty())
+            return;
 
-        for (int oldPos : shellsFired)
+        // The positions are visited in the order of a fresh unordered_set fed the same inserts,
+        // the order games have always been played in. Whatever shell now stands on a position
+        // is advanced, and the positions it reaches are the ones recorded for the next step.
+        std::unordered_set<int> order;
+        for (int key : shellsFired)
+            order.insert(key);
+        std::vector<int> newFired;
+        for (int key : order)
         {
-            auto it = shells.find(oldPos);
-            if (it == shells.end())
+            const auto [x, y] = unpair(key);
+            int oldPos = board.index(x, y);
+            int shellIndex = board.shellAt(oldPos);
+            if (shellIndex < 0)
                 continue;
 
-            std::unique_ptr<Shell> &shell = it->second;
-            bool didItMove = shell->moveForward();
-            int newPos = bijection(shell->getX(), shell->getY());
+            Shell shell(entities.shells, shellIndex, this);
+
+            bool didItMove = shell.moveForward();
+            int newPos = board.index(shell.getX(), shell.getY());
 
             // Check for wall collision
             if (!didItMove)
             {
-                // Shell hit a wall, damage wall and demolish shell
+                // Shell hit a wall, damage wall and demolish shell (it stays on its cell until removed)
                 shellHitAWall(newPos);
-                shellsToRemove.insert(oldPos);
+                shellsToRemove.push_back(oldPos);
                 continue; // Do not move shell forward
             }
 
-            if (shells.count(newPos))
+            int other = board.shellAt(newPos);
+            if (other >= 0)
             {
-                shellsToRemove.insert(newPos); // handle collision
+                shellsToRemove.push_back(newPos); // handle collision
+                destroyShell(other);
             }
 
-            shells[newPos] = std::move(shell); // move it in the map
-            newFired.insert(newPos);
-            shells.erase(oldPos);
+            board.clearShell(oldPos);
+            board.placeShell(newPos, shellIndex);
+            const int newKey = cantorKey(shell.getX(), shell.getY());
+            if (std::find(newFired.begin(), newFired.end(), newKey) == newFired.end())
+                newFired.push_back(newKey);
         }
 
         shellsFired = std::move(newFired);
@@ -124,43 +202,45 @@ namespace GameManager_212788293_212497127
 
     void GameManager::addMine(int x, int y)
     {
-        mines.insert(bijection(x, y));
+        board.addMine(board.index(x, y));
     }
 
     void GameManager::addWall(int x, int y)
     {
-        Wall wall = {x, y, 2};
-        walls[bijection(x, y)] = wall;
+        board.addWall(board.index(x, y), WALL_HEALTH);
     }
 
     void GameManager::removeMine(int x)
     {
-        mines.erase(x);
+        board.removeMine(x);
     }
 
     void GameManager::removeWall(int x)
     {
-        walls.erase(x);
+        board.removeWall(x);
     }
 
     void GameManager::removeTank(int tankPos)
     {
-        playerTanksCount[tanks[tankPos]->getPlayerId()]--;
-        movesOfTanks[tanks[tankPos].get()->getTankGlobalId()] += " (killed)";
-        tanks.erase(tankPos);
+        int tankIndex = board.tankAt(tankPos);
+        if (tankIndex < 0)
+            return;
+
+        Tank tank(entities.tanks, tankIndex, this);
+        playerTanksCount[tank.getPlayerId()]--;
+        movesOfTanks[tankIndex].killed = true;
+        tank.hit();
+        board.clearTank(tankPos);
     }
 
     void GameManager::removeShell(int ShellPos)
     {
-        shells.erase(ShellPos);
-    }
+        int shellIndex = board.shellAt(ShellPos);
+        if (shellIndex < 0)
+            return;
 
-    void GameManager::hitTank(int tankId)
-    {
-        if (tanks.count(tankId))
-        {
-            tanks[tankId]->hit();
-        }
+        board.clearShell(ShellPos);
+        destroyShell(shellIndex);
     }
 
     std::vector<std::string> GameManager::splitByComma(const std::string &input)
@@ -184,15 +264,21 @@ namespace GameManager_212788293_212497127
     {
         width = static_cast<int>(w);
         height = static_cast<int>(h);
+        board.reset(width * 2, height * 2);
+        shellArrivals.reset(board.size());
+        tankArrivals.reset(board.size());
+
+        // one bulk copy instead of a virtual call per cell
+        std::vector<char> cells(static_cast<size_t>(width) * static_cast<size_t>(height));
+        UC::copySatellite(map, w, h, cells.data());
 
         int tankId1 = 0;
         int tankId2 = 0;
-        int globalTankId = 0;
         for (int y = 0; y < height; ++y)
         {
             for (int x = 0; x < width; ++x)
             {
-                char c = map.getObjectAt(x, y);
+                char c = cells[static_cast<size_t>(y) * width + x];
                 if (c == '#')
                 {
                     addWall(x * 2, y * 2);
@@ -204,16 +290,12 @@ namespace GameManager_212788293_212497127
                 else if (c == '1' || c == '2')
                 {
                     int playerId = (c == '1') ? 1 : 2;
-                    auto tank = std::make_unique<Tank>(x * 2, y * 2,
-                                                       (playerId == 1) ? UC::DirectionsUtils::stringToDirection["L"]
-                                                                       : UC::DirectionsUtils::stringToDirection["R"],
-                                                       this, playerId, numShellsPerTank,
-                                                       (playerId == 1) ? tankId1++ : tankId2++,
-                                                       globalTankId++);
+                    addTank(x * 2, y * 2,
+                            (playerId == 1) ? UC::Direction::L : UC::Direction::R,
+                            playerId, (playerId == 1) ? tankId1++ : tankId2++);
 
                     playerTanksCount[playerId]++;
                     totalShellsRemaining += numShellsPerTank;
-                    addTank(std::move(tank));
                 }
             }
             // removed erroneous ++y here
@@ -224,58 +306,65 @@ namespace GameManager_212788293_212497127
             return *wopt;
         }
 
-        printBoard();
+        updateViews();
 
         totalTanks = tankId1 + tankId2;
-        for (int k = 0; k < totalTanks; k++)
-        {
-            movesOfTanks.push_back(" ");
-        }
+        movesOfTanks.assign(totalTanks, TankMoveRecord{});
 
         return -1;
     }
 
     void GameManager::checkForAMine(int x, int y)
     {
-        int currTankPos = bijection(x, y);
-        if (mines.count(currTankPos))
+        int currTankPos = board.index(x, y);
+        if (board.hasMine(currTankPos))
         {
-            removeMine(bijection(x, y));
-            tanksToRemove.insert(currTankPos);
+            removeMine(currTankPos);
+            tanksToRemove.push_back(currTankPos);
         }
     }
 
     void GameManager::tankHitByAShell(int tankPos)
     {
-        shellsToRemove.insert(tankPos);
-        tanksToRemove.insert(tankPos);
+        shellsToRemove.push_back(tankPos);
+        tanksToRemove.push_back(tankPos);
     }
 
     void GameManager::shellHitAWall(int wallPos)
     {
         if (getWallHealth(wallPos) <= 0)
         {
-            wallsToRemove.insert(wallPos);
+            wallsToRemove.push_back(wallPos);
         }
     }
 
     void GameManager::advanceShells()
     {
-        Shell *shell;
-        int newPos;
-        bool didItMove;
-        for (const auto &pair : shells)
+        // shells move in place; only arrivals stamped during this sub-step count as collisions,
+        // a shell still waiting on its old cell is not hit
+        ShellStore &shells = entities.shells;
+        shellArrivals.nextEpoch();
+
+        for (int i = 0; i < shells.size(); ++i)
         {
-            shell = shells[pair.first].get();
-            didItMove = shell->moveForward();
-            newPos = bijection(shell->getX(), shell->getY());
+            if (!shells.alive[i])
+                continue;
+
+            Shell shell(shells, i, this);
+            int oldPos = board.index(shell.getX(), shell.getY());
+            if (board.shellAt(oldPos) == i)
+                board.clearShell(oldPos);
+
+            bool didItMove = shell.moveForward();
+            int newPos = board.index(shell.getX(), shell.getY());
             if (didItMove)
-                checkForShellCollision(*shell);
+                checkForShellCollision(i);
             else
+            {
                 shellHitAWall(newPos);
+                destroyShell(i);
+            }
         }
-        shells = std::move(secondaryShells);
-        secondaryShells.clear();
     }
 
     void GameManager::reverseHandler(Tank &tank, ActionRequest move)
@@ -283,27 +372,27 @@ namespace GameManager_212788293_212497127
         if (move == ActionRequest::MoveForward)
         {
             tank.resetReverseState();
-            movesOfTanks[tank.getTankGlobalId()] = UC::to_string(tank.getLastMove()) + " (ignored)";
+            recordMove(tank.getTankGlobalId(), tank.getLastMove(), true);
             tank.setLastMove(ActionRequest::DoNothing);
         }
         else if (tank.isReverseQueued())
         {
-            movesOfTanks[tank.getTankGlobalId()] = UC::to_string(tank.getLastMove()) + " (ignored)";
+            recordMove(tank.getTankGlobalId(), tank.getLastMove(), true);
             tank.incrementReverseCharge();
             if (tank.isReverseReady())
             {
-                movesOfTanks[tank.getTankGlobalId()] = UC::to_string(tank.getLastMove());
+                recordMove(tank.getTankGlobalId(), tank.getLastMove());
                 tank.executeReverse();
             }
         }
         else if (move == ActionRequest::MoveBackward)
         {
             tank.queueReverse();
-            movesOfTanks[tank.getTankGlobalId()] = UC::to_string(tank.getLastMove()) + " (ignored)";
+            recordMove(tank.getTankGlobalId(), tank.getLastMove(), true);
             tank.incrementReverseCharge();
             if (tank.isReverseReady())
             {
-                movesOfTanks[tank.getTankGlobalId()] = UC::to_string(tank.getLastMove());
+                recordMove(tank.getTankGlobalId(), tank.getLastMove());
                 tank.executeReverse();
             }
         }
@@ -314,10 +403,7 @@ namespace GameManager_212788293_212497127
     {
         ActionRequest move = tank.getLastMove();
         tank.resetReverseState();
-        if (tank.moveForward())
-            movesOfTanks[tank.getTankGlobalId()] = UC::to_string(move);
-        else
-            movesOfTanks[tank.getTankGlobalId()] = UC::to_string(move) + " (ignored)";
+        recordMove(tank.getTankGlobalId(), move, !tank.moveForward());
         checkForAMine(tank.getX(), tank.getY());
     }
 
@@ -338,102 +424,128 @@ namespace GameManager_212788293_212497127
         tank.resetReverseState();
         ActionRequest move = tank.getLastMove();
         if (move == ActionRequest::RotateLeft90)
-            tank.rotateTank(-0.25);
+            tank.rotateTank(-2);
         else if (move == ActionRequest::RotateRight90)
-            tank.rotateTank(0.25);
+            tank.rotateTank(2);
         else if (move == ActionRequest::RotateLeft45)
-            tank.rotateTank(-0.125);
+            tank.rotateTank(-1);
         else if (move == ActionRequest::RotateRight45)
-            tank.rotateTank(0.125);
+            tank.rotateTank(1);
 
         tank.setLastMove(ActionRequest::DoNothing);
     }
 
     void GameManager::checkForTankCollision(Tank &tank)
     {
-        int currTankPos = bijection(tank.getX(), tank.getY());
+        int currTankPos = board.index(tank.getX(), tank.getY());
 
-        if (secondaryTanks.count(currTankPos))
+        // a tank already on the cell moved there earlier in this pass: both tanks are destroyed
+        int other = tankArrivals.get(currTankPos);
+        if (other >= 0)
         {
-            movesOfTanks[secondaryTanks[currTankPos].get()->getTankGlobalId()] = UC::to_string(tank.getLastMove()) + " (killed)";
-            playerTanksCount[secondaryTanks[currTankPos]->getPlayerId()]--;
-            tanksToRemove.insert(currTankPos);
+            Tank otherTank(entities.tanks, other, this);
+            recordMove(other, tank.getLastMove());
+            movesOfTanks[other].killed = true;
+            playerTanksCount[otherTank.getPlayerId()]--;
+            tanksToRemove.push_back(currTankPos);
+            otherTank.hit();
         }
-        if (shells.count(currTankPos))
+        if (board.shellAt(currTankPos) >= 0)
         {
             tankHitByAShell(currTankPos);
         }
 
-        secondaryTanks[currTankPos] = std::make_unique<Tank>(std::move(tank));
+        board.placeTank(currTankPos, tank.getTankGlobalId(), tank.getPlayerId());
+        tankArrivals.set(currTankPos, tank.getTankGlobalId());
     }
 
-    void GameManager::checkForShellCollision(Shell &shell)
+    void GameManager::checkForShellCollision(int shellIndex)
     {
-        int shellPos = bijection(shell.getX(), shell.getY());
-        if (tanks.count(shellPos))
+        ShellStore &shells = entities.shells;
+        int shellPos = board.index(shells.x[shellIndex], shells.y[shellIndex]);
+        if (board.tankAt(shellPos) >= 0)
             tankHitByAShell(shellPos);
-        if (secondaryShells.count(shellPos))
-            shellsToRemove.insert(shellPos);
-        secondaryShells[shellPos] = std::make_unique<Shell>(shell);
+
+        // shells already on the cell moved there earlier in this sub-step
+        int other = shellArrivals.get(shellPos);
+        if (other >= 0 && entities.shells.alive[other])
+        {
+            shellsToRemove.push_back(shellPos);
+            destroyShell(other);
+        }
+
+        board.placeShell(shellPos, shellIndex);
+        shellArrivals.set(shellPos, shellIndex);
     }
 
     void GameManager::executeTanksMoves(bool firstPass)
     {
         ActionRequest move;
 
-        for (const auto &pair : tanks)
+        // tanks move in place in position order; collisions are checked against the tanks that
+        // already arrived on a cell during this pass
+        TankStore &tanks = entities.tanks;
+        tankArrivals.nextEpoch();
+
+        for (int i : tanksInPositionOrder())
         {
-            Tank *tank = pair.second.get();
-            move = tank->getLastMove();
-            if (tank->getCantShoot())
+            if (!tanks.alive[i])
+                continue;
+            Tank tank(tanks, i, this);
+            int oldPos = board.index(tank.getX(), tank.getY());
+            if (board.tankAt(oldPos) == i)
+                board.clearTank(oldPos);
+
+            move = tank.getLastMove();
+            if (tank.getCantShoot())
             {
                 if (firstPass && move == ActionRequest::Shoot)
-                    movesOfTanks[tank->getTankGlobalId()] = UC::to_string(move) + " (ignored)";
-                tank->incrementCantShoot();
-                if (tank->getCantShoot() == 8)
-                    tank->resetCantShoot();
+                    recordMove(i, move, true);
+                tank.incrementCantShoot();
+                if (tank.getCantShoot() == 8)
+                    tank.resetCantShoot();
             }
 
-            if (tank->isReverseQueued() || move == ActionRequest::MoveBackward)
+            if (tank.isReverseQueued() || move == ActionRequest::MoveBackward)
             {
-                reverseHandler(*tank, move);
+                reverseHandler(tank, move);
             }
             else if (move == ActionRequest::MoveForward)
             {
-                advanceTank(*tank);
+                advanceTank(tank);
             }
             else if (move == ActionRequest::Shoot)
             {
-                movesOfTanks[tank->getTankGlobalId()] = UC::to_string(tank->getLastMove());
-                tankShootingShells(*tank);
+                recordMove(i, tank.getLastMove());
+                tankShootingShells(tank);
             }
             else if (move != ActionRequest::GetBattleInfo)
             {
                 if (firstPass)
-                    movesOfTanks[tank->getTankGlobalId()] = UC::to_string(tank->getLastMove());
-                rotate(*tank);
+                    recordMove(i, tank.getLastMove());
+                rotate(tank);
             }
 
-            checkForTankCollision(*tank);
+            checkForTankCollision(tank);
         }
-
-        tanks = std::move(secondaryTanks);
-        secondaryTanks.clear();
     }
 
     void GameManager::executeBattleInfoRequests(Player &player1, Player &player2)
     {
-        sortTanks();
-        for (const auto &pair : tanks)
+        TankStore &tanks = entities.tanks;
+        for (int i : tanksInPositionOrder())
         {
-            Tank *tank = pair.second.get();
+            if (!tanks.alive[i])
+                continue;
 
-            if (tank->getLastMove() == ActionRequest::GetBattleInfo)
+            if (tanks.lastMove[i] == ActionRequest::GetBattleInfo)
             {
-                TankAlgorithm *tankAlgorithm = tank->getTankAlgorithm();
-                int pos = bijection(tank->getX(), tank->getY());
-                MySatelliteView satelliteView(pos, tanks, shells, mines, walls);
-                if (tank->getPlayerId() == 1)
+                TankAlgorithm *tankAlgorithm = tanks.algorithms[i].get();
+                // a tank sees itself as '%' only while it stands on the even corner of its cell
+                int self = (tanks.x[i] % 2 == 0 && tanks.y[i] % 2 == 0) ? (tanks.y[i] / 2) * width + tanks.x[i] / 2 : -1;
+                MySatelliteView satelliteView(satellite.data(), width, height, self);
+                const auto start = std::chrono::steady_clock::now();
+                if (tanks.playerId[i] == 1)
                 {
                     player1.updateTankWithBattleInfo(*tankAlgorithm, satelliteView);
                 }
@@ -441,16 +553,12 @@ namespace GameManager_212788293_212497127
                 {
                     player2.updateTankWithBattleInfo(*tankAlgorithm, satelliteView);
                 }
-                movesOfTanks[tank->getTankGlobalId()] = UC::to_string(tank->getLastMove());
+                chargeTankCall(tanks.playerId[i], start);
+                recordMove(i, tanks.lastMove[i]);
             }
         }
     }
 
-    int GameManager::bijection(int x, int y)
-    {
-        return ((x + y) * (x + y + 1)) / 2 + y;
-    }
-
     void GameManager::removeTanks()
     {
         for (int object : tanksToRemove)
@@ -496,20 +604,6 @@ namespace GameManager_212788293_212497127
         return std::nullopt;
     }
 
-    void GameManager::sortTanks()
-    {
-        std::vector<std::pair<int, Tank *>> tankVec;
-
-        for (auto &pair : tanks)
-            tankVec.emplace_back(pair.first, pair.second.get());
-
-        std::sort(tankVec.begin(), tankVec.end(),
-                  [](const auto &a, const auto &b)
-                  {
-                      return a.second->getTankGlobalId() < b.second->getTankGlobalId();
-                  });
-    }
-
     GameResult GameManager::run(size_t map_width, size_t map_height,
                                 const SatelliteView &map,
                                 string map_name,
@@ -518,12 +612,129 @@ namespace GameManager_212788293_212497127
                                 TankAlgorithmFactory player1_tank_algo_factory,
                                 TankAlgorithmFactory player2_tank_algo_factory)
     {
+        bool played = startGame(map_width, map_height, map, map_name, max_steps, num_shells,
+                                player1, name1, player2, name2,
+                                player1_tank_algo_factory, player2_tank_algo_factory);
+        if (played)
+        {
+            while (!playStep())
+            {
+            }
+        }
+        lastTimeouts.assign(1, timeout);
+        lastPlayTimes.assign(1, playTime);
+        GameResult result = collectResult(played);
+        // the files are complete when run returns, even if the process ends without unloading us
+        if (played && verbose)
+            AsyncFileSink::instance().drain();
+        return result;
+    }
+
+    void GameManager::runBatch(size_t map_width, size_t map_height, std::vector<UC::BatchGame> &games,
+                               const GameFinished &finished)
+    {
+        // the games are played back to back on this engine: after the first one, the board, the
+        // stores and the views are already sized for the map and nothing is allocated again
+        lastTimeouts.clear();
+        lastPlayTimes.clear();
+        for (size_t g = 0; g < games.size(); ++g)
+        {
+            UC::BatchGame &game = games[g];
+            const bool played = startGame(map_width, map_height, *game.map, game.map_name,
+                                          game.max_steps, game.num_shells,
+                                          *game.player1, game.name1, *game.player2, game.name2,
+                                          game.player1_tank_algo_factory, game.player2_tank_algo_factory);
+            if (played)
+            {
+                while (!playStep())
+                {
+                }
+            }
+            GameResult result = collectResult(played);
+            lastTimeouts.push_back(timeout);
+            lastPlayTimes.push_back(playTime);
+            finished(g, std::move(result));
+        }
+        if (verbose)
+            AsyncFileSink::instance().drain();
+    }
+
+    void GameManager::setReplayDirectory(const std::string &dir)
+    {
+        replayDir = dir;
+    }
+
+    void GameManager::setFrameFormat(UC::FrameFormat format)
+    {
+        frameFormat = format;
+    }
+
+    void GameManager::setBudget(const UC::GameBudget &budget, std::shared_ptr<const UC::CancellationToken> token)
+    {
+        this->budget = budget;
+        cancellation = token;
+    }
+
+    UC::Timeout GameManager::getTimeout(size_t game) const
+    {
+        return game < lastTimeouts.size() ? lastTimeouts[game] : UC::Timeout::None;
+    }
+
+    std::chrono::duration<double> GameManager::getPlayTime(size_t game) const
+    {
+        return game < lastPlayTimes.size() ? lastPlayTimes[game] : std::chrono::steady_clock::duration{};
+    }
+
+    UC::VerboseOutputStats GameManager::getVerboseOutputStats() const
+    {
+        return AsyncFileSink::instance().stats();
+    }
+
+    void GameManager::chargeTankCall(int playerId, std::chrono::steady_clock::time_point start)
+    {
+        if (budget.tankCall.count() > 0 && std::chrono::steady_clock::now() - start > budget.tankCall)
+            overrunPlayers |= 1 << playerId;
+    }
+
+    bool GameManager::outOfBudget()
+    {
+        if (overrunPlayers != 0)
+        {
+            // the player that overran loses, a tie when both did
+            const bool first = overrunPlayers & (1 << 1), second = overrunPlayers & (1 << 2);
+            winner = first == second ? 0 : (first ? 2 : 1);
+            timeout = UC::Timeout::TankCall;
+        }
+        else if (cancellation && cancellation->isCancelled())
+        {
+            winner = 0;
+            timeout = UC::Timeout::Cancelled;
+        }
+        else if (budget.game.count() > 0 && playTime >= budget.game)
+        {
+            winner = 0;
+            timeout = UC::Timeout::GameTime;
+        }
+        else
+        {
+            return false;
+        }
+        endReason = GameResult::MAX_STEPS;
+        return true;
+    }
+
+    bool GameManager::startGame(size_t map_width, size_t map_height,
+                                const SatelliteView &map,
+                                const string &map_name,
+                                size_t max_steps, size_t num_shells,
+                                Player &player1, const string &name1, Player &player2, const string &name2,
+                                TankAlgorithmFactory &player1_tank_algo_factory,
+                                TankAlgorithmFactory &player2_tank_algo_factory)
+    {
+        const auto start = std::chrono::steady_clock::now();
         // clear any previous state
         clearGameState();
 
-        GameResult result{};
-        result.winner = 0;
-
         // set game-wide params
         maxSteps = static_cast<int>(max_steps);
         numShellsPerTank = static_cast<int>(num_shells);
@@ -532,210 +743,601 @@ namespace GameManager_212788293_212497127
         if (int w = readMap(map_width, map_height, map); w >= 0)
         {
             // game ended before round 0
-            result.winner = w;
-            result.reason = GameResult::ALL_TANKS_DEAD;
-            result.rounds = 0;
-            result.remaining_tanks = {
-                static_cast<size_t>(playerTanksCount.at(1)),
-                static_cast<size_t>(playerTanksCount.at(2))};
-            std::unique_ptr<MySatelliteView> satelliteView = std::make_unique<MySatelliteView>(-1, tanks, shells, mines, walls);
-            result.gameState = std::move(satelliteView);
-            return result;
+            winner = w;
+            endReason = GameResult::ALL_TANKS_DEAD;
+            playTime = std::chrono::steady_clock::now() - start;
+            return false;
         }
 
-        openVerboseFiles("GameManager", map_name, name1, name2);
+        if (verbose || !replayDir.empty())
+        {
+            const auto base = make_unique_base("GameManager", map_name, name1, name2);
+            openVerboseFiles(base);
+            openReplay(base, map_name, name1, name2);
+        }
 
         // step2: create tank algorithms
-        for (const auto &pair : tanks)
+        attachPlayers(player1, player2, player1_tank_algo_factory, player2_tank_algo_factory);
+        playTime = std::chrono::steady_clock::now() - start;
+        return true;
+    }
+
+    void GameManager::attachPlayers(Player &player1, Player &player2,
+                                    TankAlgorithmFactory &player1_tank_algo_factory,
+                                    TankAlgorithmFactory &player2_tank_algo_factory)
+    {
+        this->player1 = &player1;
+        this->player2 = &player2;
+
+        TankStore &tanks = entities.tanks;
+        for (int i : tanksInPositionOrder())
         {
-            Tank *tank = pair.second.get();
-            std::unique_ptr<TankAlgorithm> algo;
-            if (tank->getPlayerId() == 1)
+            if (!tanks.alive[i] || tanks.algorithms[i])
+                continue;
+            if (tanks.playerId[i] == 1)
             {
-                algo = player1_tank_algo_factory(tank->getPlayerId(), tank->getTankId());
+                tanks.algorithms[i] = player1_tank_algo_factory(tanks.playerId[i], tanks.tankId[i]);
             }
             else
             {
-                algo = player2_tank_algo_factory(tank->getPlayerId(), tank->getTankId());
+                tanks.algorithms[i] = player2_tank_algo_factory(tanks.playerId[i], tanks.tankId[i]);
             }
-
-            tank->setTankAlgorithm(std::move(algo));
         }
+    }
 
-        // step3: main loop
-        int count = 0;
+    GameSnapshot GameManager::snapshot() const
+    {
+        std::vector<std::uint8_t> bytes;
+        SnapshotWriter out(bytes);
+        out.put(SNAPSHOT_VERSION);
+        out.put(static_cast<std::int32_t>(width));
+        out.put(static_cast<std::int32_t>(height));
+        out.put(static_cast<std::int32_t>(gameStep));
+        out.put(static_cast<std::int32_t>(totalShellsRemaining));
+        out.put(static_cast<std::int32_t>(maxSteps));
+        out.put(static_cast<std::int32_t>(numShellsPerTank));
+        out.put(static_cast<std::int32_t>(totalTanks));
+        out.put(static_cast<std::int32_t>(stepsWithoutShells));
+        out.put(static_cast<std::int32_t>(winner));
+        out.put(static_cast<std::int32_t>(endReason));
+        out.put(static_cast<std::int32_t>(playerTanksCount.at(1)));
+        out.put(static_cast<std::int32_t>(playerTanksCount.at(2)));
+        out.putVector(movesOfTanks);
+        // budget accounting, so a restored game is charged and timed out like the one it came from
+        out.put(static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(playTime).count()));
+        out.put(static_cast<std::int32_t>(overrunPlayers));
+        out.put(static_cast<std::int32_t>(timeout));
+
+        board.save(out);
+        entities.tanks.save(out);
+        entities.shells.save(out);
+
+        out.putVector(wallsToRemove);
+        out.putVector(tanksToRemove);
+        out.putVector(shellsToRemove);
+        out.putVector(shellsFired);
+        return GameSnapshot(std::move(bytes));
+    }
 
-        while (true)
+    void GameManager::restore(const GameSnapshot &snapshot)
+    {
+        // everything is decoded and checked before the engine is touched: a truncated or corrupt
+        // snapshot throws and leaves the game in progress as it was
+        SnapshotReader in(snapshot);
+        if (in.get<std::uint32_t>() != SNAPSHOT_VERSION)
+            corruptSnapshot("unsupported snapshot version");
+        const int loadedWidth = in.get<std::int32_t>();
+        const int loadedHeight = in.get<std::int32_t>();
+        const int loadedGameStep = in.get<std::int32_t>();
+        const int loadedShellsRemaining = in.get<std::int32_t>();
+        const int loadedMaxSteps = in.get<std::int32_t>();
+        const int loadedShellsPerTank = in.get<std::int32_t>();
+        const int loadedTotalTanks = in.get<std::int32_t>();
+        const int loadedStepsWithoutShells = in.get<std::int32_t>();
+        const int loadedWinner = in.get<std::int32_t>();
+        const int loadedEndReason = in.get<std::int32_t>();
+        const int loadedTanksCount1 = in.get<std::int32_t>();
+        const int loadedTanksCount2 = in.get<std::int32_t>();
+        std::vector<TankMoveRecord> loadedMoves;
+        in.getVector(loadedMoves);
+        const std::int64_t loadedPlayTime = in.get<std::int64_t>();
+        const int loadedOverrun = in.get<std::int32_t>();
+        const int loadedTimeout = in.get<std::int32_t>();
+
+        Board loadedBoard;
+        loadedBoard.load(in);
+        EntityStore loaded;
+        loaded.tanks.load(in);
+        loaded.shells.load(in);
+
+        std::vector<int> loadedWallsToRemove, loadedTanksToRemove, loadedShellsToRemove, loadedShellsFired;
+        in.getVector(loadedWallsToRemove);
+        in.getVector(loadedTanksToRemove);
+        in.getVector(loadedShellsToRemove);
+        in.getVector(loadedShellsFired);
+        if (in.remaining() != 0)
+            corruptSnapshot("trailing bytes");
+
+        // the doubled board is even and positive, halving it cannot overflow like doubling the map size
+        if (loadedBoard.getWidth() / 2 != loadedWidth || loadedBoard.getHeight() / 2 != loadedHeight)
+            corruptSnapshot("board does not match the map size");
+        if (loadedGameStep < 0 || loadedShellsRemaining < 0 || loadedMaxSteps < 0 || loadedShellsPerTank < 0 ||
+            loadedStepsWithoutShells < 0 || loadedTanksCount1 < 0 || loadedTanksCount2 < 0)
+            corruptSnapshot("negative counter");
+        if (loadedWinner < 0 || loadedWinner > 2 || loadedEndReason < GameResult::ALL_TANKS_DEAD ||
+            loadedEndReason > GameResult::ZERO_SHELLS || (loadedOverrun & ~((1 << 1) | (1 << 2))) != 0 ||
+            loadedTimeout < static_cast<int>(UC::Timeout::None) || loadedTimeout > static_cast<int>(UC::Timeout::Cancelled))
+            corruptSnapshot("bad game outcome");
+
+        const TankStore &loadedTanks = loaded.tanks;
+        const ShellStore &loadedShells = loaded.shells;
+        if (loadedTotalTanks != loadedTanks.size() || loadedMoves.size() != static_cast<size_t>(loadedTanks.size()))
+            corruptSnapshot("tank count mismatch");
+        // bools are checked through their bytes, reading a bool holding anything else is undefined
+        const auto validFlag = [](const bool &flag)
         {
-            for (const auto &pair : tanks)
-            {
-                Tank *tank = pair.second.get();
-                TankAlgorithm *algo = tank->getTankAlgorithm();
-                ActionRequest move = algo->getAction();
-                tank->setLastMove(move);
-            }
-            executeBattleInfoRequests(player1, player2);
-            advanceShells();
-            removeShells();
-            advanceShells();
-            removeObjectsFromTheBoard();
-            executeTanksMoves(true);
-            advanceShellsRecentlyFired();
-            removeTanks();
-            removeShells();
-
-            executeTanksMoves(false);
-
-            removeObjectsFromTheBoard();
-
-            advanceShells();
-            removeShells();
-            advanceShells();
-            removeObjectsFromTheBoard();
-
-            outputTankMoves();
-            gameStep++;
-            printBoard();
-
-            if (auto w = winnerByTanks())
+            std::uint8_t byte;
+            std::memcpy(&byte, &flag, 1);
+            return byte <= 1;
+        };
+        for (const TankMoveRecord &record : loadedMoves)
+        {
+            if (static_cast<int>(record.action) < 0 || record.action > ActionRequest::DoNothing || !validFlag(record.recorded) ||
+                !validFlag(record.ignored) || !validFlag(record.killed) || !validFlag(record.dead))
+                corruptSnapshot("bad move record");
+        }
+        const auto onBoard = [&](int x, int y)
+        { return x >= 0 && y >= 0 && x < loadedBoard.getWidth() && y < loadedBoard.getHeight(); };
+        for (int i = 0; i < loadedTanks.size(); ++i)
+        {
+            if (!onBoard(loadedTanks.x[i], loadedTanks.y[i]))
+                corruptSnapshot("tank off the board");
+        }
+        for (int i = 0; i < loadedShells.size(); ++i)
+        {
+            if (!onBoard(loadedShells.x[i], loadedShells.y[i]))
+                corruptSnapshot("shell off the board");
+        }
+        for (const std::vector<int> *queue : {&loadedWallsToRemove, &loadedTanksToRemove, &loadedShellsToRemove})
+        {
+            for (int cell : *queue)
             {
-                result.winner = *w;
-                result.reason = GameResult::ALL_TANKS_DEAD;
-                break;
+                if (cell < 0 || cell >= loadedBoard.size())
+                    corruptSnapshot("removal of a cell off the board");
             }
-            else if (gameStep >= maxSteps)
+        }
+        for (int key : loadedShellsFired)
+        {
+            if (key < 0)
+                corruptSnapshot("fired shell off the board");
+            const auto [x, y] = unpair(key);
+            if (!onBoard(x, y))
+                corruptSnapshot("fired shell off the board");
+        }
+
+        // commit; the tank algorithms already attached stay with their tanks
+        const int kept = std::min(entities.tanks.size(), loaded.tanks.size());
+        for (int i = 0; i < kept; ++i)
+            loaded.tanks.algorithms[i] = std::move(entities.tanks.algorithms[i]);
+        width = loadedWidth;
+        height = loadedHeight;
+        gameStep = loadedGameStep;
+        totalShellsRemaining = loadedShellsRemaining;
+        maxSteps = loadedMaxSteps;
+        numShellsPerTank = loadedShellsPerTank;
+        totalTanks = loadedTotalTanks;
+        stepsWithoutShells = loadedStepsWithoutShells;
+        winner = loadedWinner;
+        endReason = static_cast<GameResult::Reason>(loadedEndReason);
+        playerTanksCount[1] = loadedTanksCount1;
+        playerTanksCount[2] = loadedTanksCount2;
+        movesOfTanks = std::move(loadedMoves);
+        playTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(loadedPlayTime));
+        overrunPlayers = loadedOverrun;
+        timeout = static_cast<UC::Timeout>(loadedTimeout);
+        board = std::move(loadedBoard);
+        entities = std::move(loaded);
+        wallsToRemove = std::move(loadedWallsToRemove);
+        tanksToRemove = std::move(loadedTanksToRemove);
+        shellsToRemove = std::move(loadedShellsToRemove);
+        shellsFired = std::move(loadedShellsFired);
+
+        // the satellite grid and the frame are rebuilt from scratch below
+        satellite.clear();
+        frame.clear();
+        // every live tank and shell owns the cell it stands on
+        const TankStore &tanks = entities.tanks;
+        for (int i = 0; i < tanks.size(); ++i)
+        {
+            if (tanks.alive[i])
+                board.placeTank(board.index(tanks.x[i], tanks.y[i]), i, tanks.playerId[i]);
+        }
+        const ShellStore &shells = entities.shells;
+        for (int i = 0; i < shells.size(); ++i)
+        {
+            if (shells.alive[i])
+                board.placeShell(board.index(shells.x[i], shells.y[i]), i);
+        }
+        shellArrivals.reset(board.size());
+        tankArrivals.reset(board.size());
+        updateViews();
+    }
+
+    std::unique_ptr<GameManager> GameManager::fork() const
+    {
+        auto engine = std::make_unique<GameManager>(false);
+        engine->restore(snapshot());
+        return engine;
+    }
+
+    bool GameManager::playStep()
+    {
+        const auto stepStart = std::chrono::steady_clock::now();
+        TankStore &tanks = entities.tanks;
+        for (int i : tanksInPositionOrder())
+        {
+            // a tank revived by restore() without a new algorithm attached stays idle
+            if (!tanks.alive[i])
+                continue;
+            if (!tanks.algorithms[i])
             {
-                result.winner = 0;
-                result.reason = GameResult::MAX_STEPS;
-                break;
+                tanks.lastMove[i] = ActionRequest::DoNothing;
+                continue;
             }
-            else if (totalShellsRemaining <= 0)
+            const auto start = std::chrono::steady_clock::now();
+            tanks.lastMove[i] = tanks.algorithms[i]->getAction();
+            chargeTankCall(tanks.playerId[i], start);
+        }
+        if (replay.isOpen())
+        {
+            for (int i = 0; i < tanks.size(); ++i)
+                requestedMoves[i] = tanks.alive[i] ? static_cast<std::uint8_t>(tanks.lastMove[i]) : UC::Replay::NO_ACTION;
+        }
+        executeBattleInfoRequests(*player1, *player2);
+        advanceShells();
+        removeShells();
+        advanceShells();
+        removeObjectsFromTheBoard();
+        executeTanksMoves(true);
+        advanceShellsRecentlyFired();
+        removeTanks();
+        removeShells();
+
+        executeTanksMoves(false);
+
+        removeObjectsFromTheBoard();
+
+        advanceShells();
+        removeShells();
+        advanceShells();
+        removeObjectsFromTheBoard();
+
+        recordReplayMoves(); // before outputTankMoves marks killed tanks as dead
+        outputTankMoves();
+        gameStep++;
+        updateViews();
+        printBoard();
+        recordReplayFrame();
+        playTime += std::chrono::steady_clock::now() - stepStart;
+
+        if (auto w = winnerByTanks())
+        {
+            winner = *w;
+            endReason = GameResult::ALL_TANKS_DEAD;
+            return true;
+        }
+        else if (gameStep >= maxSteps)
+        {
+            winner = 0;
+            endReason = GameResult::MAX_STEPS;
+            return true;
+        }
+        else if (totalShellsRemaining <= 0)
+        {
+            stepsWithoutShells++;
+            if (stepsWithoutShells == MAX_STEPS_WITHOUT_SHELLS)
             {
-                count++;
-                if (count == MAX_STEPS_WITHOUT_SHELLS)
-                {
-                    result.winner = 0;
-                    result.reason = GameResult::ZERO_SHELLS;
-                    break;
-                }
+                winner = 0;
+                endReason = GameResult::ZERO_SHELLS;
+                return true;
             }
         }
+        return outOfBudget();
+    }
 
-        // step4: declare results
+    GameResult GameManager::collectResult(bool played)
+    {
+        GameResult result{};
+        result.winner = winner;
+        result.reason = endReason;
         result.rounds = gameStep;
         result.remaining_tanks = {
             static_cast<size_t>(playerTanksCount.at(1)),
             static_cast<size_t>(playerTanksCount.at(2))};
-        std::unique_ptr<MySatelliteView> satelliteView = std::make_unique<MySatelliteView>(-1, tanks, shells, mines, walls);
-        result.gameState = std::move(satelliteView);
+        // the final state owns a copy, the grid is reused by the next game
+        updateViews();
+        result.gameState = std::make_unique<MySatelliteView>(std::vector<char>(satellite), width, height);
 
-        if (verbose)
+        if (played)
+            replay.finish(result);
+
+        if (played && verbose)
         {
-            moves_out << "Summary: winner=" << result.winner << " reason=" << result.reason
+            moves_out << "Summary: winner=" << result.winner << " reason=" << static_cast<int>(result.reason)
                       << " total game steps=" << gameStep
                       << " player1 remaining tanks= " << result.remaining_tanks[0]
-                      << " player2 remaining tanks= " << result.remaining_tanks[1] << std::endl;
+                      << " player2 remaining tanks= " << result.remaining_tanks[1];
+            if (timeout != UC::Timeout::None)
+                moves_out << " timeout=" << UC::timeoutName(timeout);
+            moves_out << '\n';
         }
+        // the writer thread finishes the files in the background
+        moves_out.close();
+        viz_out.close();
 
         return result;
-    };
+    }
 
-    void GameManager::printBoard()
+    void GameManager::renderFrame()
     {
-        if (!verbose)
-            return;
-        std::vector<std::vector<char>> board(height, std::vector<char>(width, '.'));
-        std::pair<int, int> xy;
+        frame.assign(static_cast<size_t>(width) * static_cast<size_t>(height), '.');
 
-        for (const auto &pair : walls)
+        // walls and mines only ever sit on even cells of the doubled grid
+        for (int y = 0; y < height; ++y)
         {
-            int x = pair.second.x / 2;
-            int y = pair.second.y / 2;
-            short health = pair.second.health;
-            if (health == 2)
-                board[y][x] = '#';
-            else if (health == 1)
-                board[y][x] = '/';
+            for (int x = 0; x < width; ++x)
+            {
+                const Cell &cell = board.at(board.index(x * 2, y * 2));
+                if (cell.kind & WallCell)
+                {
+                    if (cell.health == 2)
+                        frame[y * width + x] = '#';
+                    else if (cell.health == 1)
+                        frame[y * width + x] = '/';
+                }
+                if (cell.kind & MineCell)
+                    frame[y * width + x] = '@';
+            }
         }
 
-        for (const auto &mine : mines)
+        const ShellStore &shells = entities.shells;
+        for (int i = 0; i < shells.size(); ++i)
         {
-            xy = UC::inverseBijection(mine);
-            int x = xy.first / 2;
-            int y = xy.second / 2;
-            board[y][x] = '@';
+            if (!shells.alive[i])
+                continue;
+            frame[(shells.y[i] / 2) * width + shells.x[i] / 2] = '*';
         }
 
-        for (const auto &pair : shells)
+        const TankStore &tanks = entities.tanks;
+        for (int i = 0; i < tanks.size(); ++i)
         {
-            Shell *a = pair.second.get();
-            int x = a->getX() / 2;
-            int y = a->getY() / 2;
-            board[y][x] = '*';
+            if (!tanks.alive[i])
+                continue;
+            char symbol = '0' + (tanks.playerId[i] % 10);
+            frame[(tanks.y[i] / 2) * width + tanks.x[i] / 2] = symbol;
         }
+    }
 
-        for (const auto &pair : tanks)
+    char GameManager::frameSymbol(int cell) const
+    {
+        // same precedence as renderFrame(): tank (highest id) over shell over mine over wall
+        const int x = board.getMapGrid().xOf(cell) * 2;
+        const int y = board.getMapGrid().yOf(cell) * 2;
+        int tank = -1;
+        int owner = 0;
+        bool shell = false;
+        for (int dy = 0; dy < 2; ++dy)
         {
-            Tank *tank = pair.second.get();
-            int x = tank->getX() / 2;
-            int y = tank->getY() / 2;
-            char symbol = '0' + (tank->getPlayerId() % 10);
-            board[y][x] = symbol;
+            for (int dx = 0; dx < 2; ++dx)
+            {
+                const Cell &part = board.at(board.index(x + dx, y + dy));
+                if (part.kind & ShellCell)
+                    shell = true;
+                if ((part.kind & TankCell) && part.tank > tank)
+                {
+                    tank = part.tank;
+                    owner = part.owner;
+                }
+            }
+        }
+        if (tank >= 0)
+            return '0' + (owner % 10);
+        if (shell)
+            return '*';
+
+        const Cell &base = board.at(board.index(x, y));
+        if (base.kind & MineCell)
+            return '@';
+        if (base.kind & WallCell)
+        {
+            if (base.health == 2)
+                return '#';
+            if (base.health == 1)
+                return '/';
         }
+        return '.';
+    }
 
-        viz_out << "\n=== Game Step " << gameStep << " ===\n";
-        for (int y = 0; y < height; ++y)
+    char GameManager::satelliteSymbol(int cell) const
+    {
+        // the satellite only looks at the even corner of a map cell
+        const UC::GridIndex &map = board.getMapGrid();
+        const Cell &corner = board.at(board.index(map.xOf(cell) * 2, map.yOf(cell) * 2));
+        if (corner.kind & TankCell)
+            return static_cast<char>('0' + corner.owner);
+        if (corner.kind & ShellCell)
+            return '*';
+        if (corner.kind & MineCell)
+            return '@';
+        if (corner.kind & WallCell)
+            return '#';
+        return ' ';
+    }
+
+    void GameManager::updateViews()
+    {
+        frameChanges.clear();
+        const size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height);
+        const bool rendering = verbose || !replayDir.empty();
+        if (satellite.size() != cells)
         {
-            for (int x = 0; x < width; ++x)
+            // first round of a game (or a restored state): everything changed
+            satellite.resize(cells);
+            for (size_t i = 0; i < cells; ++i)
+                satellite[i] = satelliteSymbol(static_cast<int>(i));
+        }
+        else
+        {
+            for (int cell : board.getDirtyCells())
+                satellite[cell] = satelliteSymbol(cell);
+        }
+
+        if (rendering && frame.size() != cells)
+        {
+            renderFrame();
+            for (size_t i = 0; i < cells; ++i)
+                frameChanges.push_back(static_cast<int>(i));
+        }
+        else if (rendering)
+        {
+            for (int cell : board.getDirtyCells())
             {
-                viz_out << board[y][x];
+                char symbol = frameSymbol(cell);
+                if (frame[cell] != symbol)
+                {
+                    frame[cell] = symbol;
+                    frameChanges.push_back(cell);
+                }
             }
+        }
+        board.clearDirty();
+    }
+
+    void GameManager::printBoard()
+    {
+        if (!verbose)
+            return;
+
+        const bool keyFrame = frameFormat == UC::FrameFormat::Full || gameStep <= 1 ||
+                              gameStep % UC::Replay::KEYFRAME_INTERVAL == 0;
+        if (!keyFrame)
+        {
+            viz_out << "\n=== Game Step " << gameStep << " (delta) ===\n";
+            for (int cell : frameChanges)
+                viz_out << cell % width << ' ' << cell / width << ' ' << frame[cell] << '\n';
             viz_out << '\n';
+            return;
+        }
+
+        viz_out << "\n=== Game Step " << gameStep << " ===\n";
+        for (int y = 0; y < height; ++y)
+        {
+            viz_out.write(frame.data() + static_cast<size_t>(y) * width, width);
+            viz_out << '\n';
+        }
+        viz_out << '\n';
+    }
+
+    void GameManager::recordReplayMoves()
+    {
+        if (!replay.isOpen())
+            return;
+        replay.beginStep(gameStep + 1);
+        for (int i = 0; i < totalTanks; i++)
+        {
+            const TankMoveRecord &record = movesOfTanks[i];
+            std::uint8_t outcome = static_cast<std::uint8_t>(record.action) & UC::Replay::ACTION_MASK;
+            if (record.recorded)
+                outcome |= UC::Replay::RECORDED;
+            if (record.ignored)
+                outcome |= UC::Replay::IGNORED;
+            if (record.killed)
+                outcome |= UC::Replay::KILLED;
+            if (record.dead)
+                outcome |= UC::Replay::DEAD;
+            replay.addTank(requestedMoves[i], outcome);
         }
-        viz_out << std::endl;
+    }
+
+    void GameManager::recordReplayFrame()
+    {
+        if (!replay.isOpen())
+            return;
+        replay.addFrame(frame, frameChanges);
     }
 
     void GameManager::outputTankMoves()
     {
         if (!verbose)
             return;
-        int wordSize = 0;
         for (int i = 0; i < totalTanks; i++)
         {
-            wordSize = static_cast<int>(movesOfTanks[i].size());
-            moves_out << movesOfTanks[i];
-            if (wordSize > 0 && movesOfTanks[i][wordSize - 1] == ')' && wordSize >= 9 &&
-                movesOfTanks[i].substr(wordSize - 9, 9) == " (killed)")
-                movesOfTanks[i] = "killed";
+            TankMoveRecord &record = movesOfTanks[i];
+            if (record.dead)
+                moves_out << "killed";
+            else
+            {
+                if (record.recorded)
+                    moves_out << UC::to_string(record.action);
+                else
+                    moves_out << ' ';
+                if (record.ignored)
+                    moves_out << " (ignored)";
+                if (record.killed)
+                {
+                    moves_out << " (killed)";
+                    record.dead = true;
+                }
+            }
             if (i != totalTanks - 1)
                 moves_out << ", ";
         }
         moves_out << "\n";
     }
 
-    void GameManager::openVerboseFiles(const std::string &gmName,
-                                       const std::string &mapName,
-                                       const std::string &alg1Name,
-                                       const std::string &alg2Name)
+    void GameManager::openVerboseFiles(const std::string &base)
     {
-
         if (!verbose)
             return;
         std::filesystem::create_directories(verbose_dir);
         std::filesystem::create_directories(visualization_dir);
-        const auto base = make_unique_base(gmName, mapName, alg1Name, alg2Name);
         const auto moves_path = std::filesystem::path(verbose_dir) / (base + ".moves.txt");
         const auto viz_path = std::filesystem::path(visualization_dir) / (base + ".viz.txt");
-        moves_out.open(moves_path, std::ios::out | std::ios::trunc);
-        viz_out.open(viz_path, std::ios::out | std::ios::trunc);
+        moves_out.open(moves_path.string());
+        viz_out.open(viz_path.string());
+    }
+
+    void GameManager::openReplay(const std::string &base,
+                                 const std::string &mapName,
+                                 const std::string &alg1Name,
+                                 const std::string &alg2Name)
+    {
+        if (replayDir.empty())
+            return;
+        std::filesystem::create_directories(replayDir);
+        const auto replay_path = std::filesystem::path(replayDir) / (base + ".replay");
+
+        ReplayHeader header;
+        header.width = width;
+        header.height = height;
+        header.maxSteps = maxSteps;
+        header.numShells = numShellsPerTank;
+        header.tankCount = totalTanks;
+        header.gameManager = "GameManager";
+        header.mapName = mapName;
+        header.player1 = alg1Name;
+        header.player2 = alg2Name;
+
+        updateViews();
+        if (replay.open(replay_path.string(), header, frame))
+            requestedMoves.assign(totalTanks, UC::Replay::NO_ACTION);
     }
 
     void GameManager::clearGameState()
     {
-        if (moves_out.is_open())
-            moves_out.close();
-        if (viz_out.is_open())
-            viz_out.close();
+        replay.close();
+        moves_out.close();
+        viz_out.close();
 
         width = 0;
         height = 0;
@@ -744,24 +1346,29 @@ namespace GameManager_212788293_212497127
         maxSteps = 0;
         numShellsPerTank = 0;
         totalTanks = 0;
+        stepsWithoutShells = 0;
+        winner = 0;
+        endReason = GameResult::ALL_TANKS_DEAD;
+        overrunPlayers = 0;
+        timeout = UC::Timeout::None;
+        playTime = {};
+        player1 = nullptr;
+        player2 = nullptr;
 
         movesOfTanks.clear();
+        satellite.clear();
+        frame.clear();
 
         playerTanksCount.clear();
         playerTanksCount[1] = 0;
         playerTanksCount[2] = 0;
 
-        tanks.clear();
-        secondaryTanks.clear();
-
-        shells.clear();
-        secondaryShells.clear();
+        entities.clear();
+        tanksToRemove.clear();
         shellsToRemove.clear();
         shellsFired.clear();
 
-        mines.clear();
-
-        walls.clear();
+        board.reset(0, 0);
         wallsToRemove.clear();
     }
 }
@@ -7,7 +7,7 @@ namespace GameManager_212788293_212497127
 {
     // ------------------------ MovingGameObject ------------------------
 
-    GameObject::GameObject(int x, int y, UC::Direction dir, GameManager* game)
+    GameObject::GameObject(int &x, int &y, UC::Direction &dir, GameManager* game)
         : x(x), y(y), direction(dir), game(game) {}
 
     int GameObject::getX()
@@ -1,29 +1,46 @@
 #include <cstddef>
+#include <cstring>
 #include "MySatelliteView.h"
 
 namespace GameManager_212788293_212497127
 {
-    MySatelliteView::MySatelliteView(int tankPos,
-                                     const std::map<int, std::unique_ptr<Tank>> &tanks,
-                                     const std::unordered_map<int, std::unique_ptr<Shell>> &shells,
-                                     const std::set<int> &mines,
-                                     const std::unordered_map<int, Wall> &walls)
-        : tankPos(tankPos), tanks(tanks), shells(shells), mines(mines), walls(walls) {}
+    MySatelliteView::MySatelliteView(const char *cells, size_t width, size_t height, int selfCell)
+        : cells(cells), width(width), height(height), self(static_cast<size_t>(selfCell)) {}
+
+    MySatelliteView::MySatelliteView(std::vector<char> grid, size_t width, size_t height)
+        : owned(std::move(grid)), cells(owned.data()), width(width), height(height), self(static_cast<size_t>(-1)) {}
 
     char MySatelliteView::getObjectAt(size_t x, size_t y) const
     {
-        int bijectionIndex = UC::bijection(2 * x, 2 * y);
-        if (bijectionIndex == tankPos)
+        if (x >= width || y >= height)
+            return '&';
+        const size_t cell = y * width + x;
+        if (cell == self)
             return '%'; // Current Tank
-        if (tanks.count(bijectionIndex))
-            return (char)('0' + tanks.at(bijectionIndex)->getPlayerId());
-        if (shells.count(bijectionIndex))
-            return '*'; // Shell
-        if (mines.count(bijectionIndex))
-            return '@'; // Mine
-        if (walls.count(bijectionIndex))
-            return '#'; // Wall
+        return cells[cell];
+    }
+
+    void MySatelliteView::copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const
+    {
+        if (x == 0 && w == width && stride == width)
+            std::memcpy(out, cells + y * width, w * h);
+        else
+        {
+            for (size_t row = 0; row < h; ++row)
+                std::memcpy(out + row * stride, cells + (y + row) * width + x, w);
+        }
 
-        return ' ';
+        if (self < width * height)
+        {
+            const size_t selfX = self % width;
+            const size_t selfY = self / width;
+            if (selfX >= x && selfX < x + w && selfY >= y && selfY < y + h)
+                out[(selfY - y) * stride + (selfX - x)] = '%';
+        }
+    }
+
+    UC::SatelliteSpan MySatelliteView::span() const
+    {
+        return {cells, width, height, self};
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,118 @@
+#include "ReplayWriter.h"
+#include "Snapshot.h"
+
+namespace UC = UserCommon_212788293_212497127;
+
+namespace GameManager_212788293_212497127
+{
+    namespace
+    {
+        constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+    }
+
+    // ------------------------ ReplayWriter ------------------------
+
+    bool ReplayWriter::open(const std::string &path, const ReplayHeader &header, const std::vector<char> &initialFrame)
+    {
+        close();
+        out.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!out.is_open())
+            return false;
+
+        buffer.clear();
+        SnapshotWriter writer(buffer);
+        for (char c : UC::Replay::MAGIC)
+            writer.put(c);
+        writer.put(UC::Replay::VERSION);
+        writer.put(static_cast<std::uint16_t>(header.width));
+        writer.put(static_cast<std::uint16_t>(header.height));
+        writer.put(static_cast<std::uint32_t>(header.maxSteps));
+        writer.put(static_cast<std::uint32_t>(header.numShells));
+        writer.put(static_cast<std::uint16_t>(header.tankCount));
+        writer.put(UC::Replay::KEYFRAME_INTERVAL);
+        putString(header.gameManager);
+        putString(header.mapName);
+        putString(header.player1);
+        putString(header.player2);
+        buffer.insert(buffer.end(), initialFrame.begin(), initialFrame.end());
+
+        frameCells = initialFrame.size();
+        framesSinceKeyFrame = UC::Replay::KEYFRAME_INTERVAL; // the first step is a keyframe
+        return true;
+    }
+
+    void ReplayWriter::putString(const std::string &value)
+    {
+        SnapshotWriter(buffer).put(static_cast<std::uint16_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    void ReplayWriter::beginStep(int step)
+    {
+        SnapshotWriter writer(buffer);
+        writer.put(UC::Replay::STEP_RECORD);
+        writer.put(static_cast<std::uint32_t>(step));
+    }
+
+    void ReplayWriter::addTank(std::uint8_t requested, std::uint8_t outcome)
+    {
+        buffer.push_back(requested);
+        buffer.push_back(outcome);
+    }
+
+    void ReplayWriter::addFrame(const std::vector<char> &frame, const std::vector<int> &changedCells)
+    {
+        SnapshotWriter writer(buffer);
+        // a delta costs 5 bytes per cell, past a fifth of the map a keyframe is smaller
+        if (framesSinceKeyFrame >= UC::Replay::KEYFRAME_INTERVAL || frame.size() != frameCells ||
+            changedCells.size() * 5 >= frame.size())
+        {
+            writer.put(UC::Replay::KEY_FRAME);
+            buffer.insert(buffer.end(), frame.begin(), frame.end());
+            frameCells = frame.size();
+            framesSinceKeyFrame = 1;
+        }
+        else
+        {
+            writer.put(UC::Replay::DELTA_FRAME);
+            writer.put(static_cast<std::uint32_t>(changedCells.size()));
+            for (int cell : changedCells)
+            {
+                writer.put(static_cast<std::uint32_t>(cell));
+                writer.put(frame[cell]);
+            }
+            ++framesSinceKeyFrame;
+        }
+
+        if (buffer.size() >= FLUSH_THRESHOLD)
+            flush();
+    }
+
+    void ReplayWriter::finish(const GameResult &result)
+    {
+        if (!out.is_open())
+            return;
+        SnapshotWriter writer(buffer);
+        writer.put(UC::Replay::END_RECORD);
+        writer.put(static_cast<std::int32_t>(result.winner));
+        writer.put(static_cast<std::uint8_t>(result.reason));
+        writer.put(static_cast<std::uint32_t>(result.rounds));
+        writer.put(static_cast<std::uint32_t>(result.remaining_tanks[0]));
+        writer.put(static_cast<std::uint32_t>(result.remaining_tanks[1]));
+        close();
+    }
+
+    void ReplayWriter::flush()
+    {
+        out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    void ReplayWriter::close()
+    {
+        if (!out.is_open())
+            return;
+        flush();
+        out.close();
+    }
+}
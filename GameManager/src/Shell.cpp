@@ -8,20 +8,16 @@ namespace GameManager_212788293_212497127
 {
     // ------------------------ Shell ------------------------
 
-    Shell::Shell(int x, int y, UC::Direction dir, GameManager* game)
-        : GameObject(x, y, dir, game) {}
+    Shell::Shell(ShellStore &store, int index, GameManager* game)
+        : GameObject(store.x[index], store.y[index], store.direction[index], game) {}
 
     bool Shell::checkForAWall()
     {
-        Wall *currWall;
-        int wallPos;
-        std::string n;
-        std::unordered_map<int, Wall> &walls = game->getWalls();
-        wallPos = game->bijection(x, y);
-        if (walls.count(wallPos))
+        Board &board = game->getBoard();
+        int wallPos = board.index(x, y);
+        if (board.hasWall(wallPos))
         {
-            currWall = &walls[wallPos];
-            currWall->health -= 1;
+            board.damageWall(wallPos);
             updatePosition(direction);
             return true;
         }
@@ -0,0 +1,23 @@
+#include "StampGrid.h"
+
+namespace GameManager_212788293_212497127
+{
+    // ------------------------ StampGrid ------------------------
+
+    void StampGrid::reset(int cellCount)
+    {
+        epoch = 1;
+        stamps.assign(static_cast<size_t>(cellCount), 0);
+        values.resize(static_cast<size_t>(cellCount));
+    }
+
+    void StampGrid::nextEpoch()
+    {
+        if (++epoch == 0)
+        {
+            // the counter wrapped around, stale stamps could match again
+            stamps.assign(stamps.size(), 0);
+            epoch = 1;
+        }
+    }
+}
@@ -7,45 +7,34 @@ namespace GameManager_212788293_212497127
 {
     // ------------------------ Tank ------------------------
 
-    Tank::Tank(int x, int y, UC::Direction dir, GameManager* game, int playerId, int shells, int tankId, int tankGlobalId)
-        : GameObject(x, y, dir, game), playerId(playerId), artilleryShells(shells), tankId(tankId), tankGlobalId(tankGlobalId)
-    {
-        cantShoot = 0;
-        destroyed = false;
-        reverseQueued = false;
-        reverseReady = false;
-        reverseCharge = 0;
-        lastMove = ActionRequest::DoNothing;
-    }
+    Tank::Tank(TankStore &store, int index, GameManager* game)
+        : GameObject(store.x[index], store.y[index], store.direction[index], game), store(store), index(index) {}
 
-    int Tank::getPlayerId() { return playerId; }
+    int Tank::getPlayerId() { return store.playerId[index]; }
 
-    int Tank::getTankId() { return tankId; }
+    int Tank::getTankId() { return store.tankId[index]; }
 
-    ActionRequest Tank::getLastMove() { return lastMove; }
+    ActionRequest Tank::getLastMove() { return store.lastMove[index]; }
 
     void Tank::setLastMove(ActionRequest currentMove)
     {
-        lastMove = currentMove;
+        store.lastMove[index] = currentMove;
     }
 
     void Tank::ignoreMove()
     {
-        lastMove = ActionRequest::DoNothing;
+        store.lastMove[index] = ActionRequest::DoNothing;
     }
 
     int Tank::getTankGlobalId()
     {
-        return tankGlobalId;
+        return index;
     }
 
     void Tank::setDirection(std::string directionStr)
     {
-        if (UC::DirectionsUtils::stringToDirection.find(directionStr) != UC::DirectionsUtils::stringToDirection.end())
-        {
-            this->direction = UC::DirectionsUtils::stringToDirection[directionStr];
-        }
-        
+        if (std::optional<UC::Direction> dir = UC::DirectionsUtils::stringToDirection(directionStr))
+            this->direction = *dir;
     }
 
     void Tank::moveBackwards()
@@ -58,92 +47,91 @@ namespace GameManager_212788293_212497127
     bool Tank::checkForAWall()
     {
         updatePosition(direction);
-        if (game->getWalls().count(game->bijection(x, y)) == 1)
+        Board &board = game->getBoard();
+        if (board.hasWall(board.index(x, y)))
         {
             updatePosition(UC::DirectionsUtils::reverseDirection[direction]);
-            lastMove = ActionRequest::DoNothing;
+            store.lastMove[index] = ActionRequest::DoNothing;
 
             return true;
         }
         updatePosition(UC::DirectionsUtils::reverseDirection[direction]);
-        if (reverseReady)
-            lastMove = ActionRequest::MoveBackward;
+        if (store.reverseReady[index])
+            store.lastMove[index] = ActionRequest::MoveBackward;
         return false;
     }
 
-    void Tank::rotateTank(double angle)
+    void Tank::rotateTank(int eighths)
     {
-        if (angle == 0)
-            return;
-        direction += angle;
+        direction = UC::DirectionsUtils::rotate(direction, eighths);
     }
 
     void Tank::fire()
     {
-        if (artilleryShells > 0)
+        if (store.artilleryShells[index] > 0)
         {
-            artilleryShells--;
-            auto shell = std::make_unique<Shell>(x, y, direction, game);
-            shell->moveForward();
-            game->addShell(std::move(shell));
+            store.artilleryShells[index]--;
+            EntityHandle handle = game->spawnShell(x, y, direction);
+            Shell shell(game->getEntities().shells, handle.index, game);
+            shell.moveForward();
+            game->addShell(handle);
         }
     }
 
     void Tank::hit()
     {
-        destroyed = true;
-        game->removeTank(tankId);
+        store.kill(index);
     }
 
-    void Tank::incrementCantShoot() { cantShoot += 1; }
+    void Tank::incrementCantShoot() { store.cantShoot[index] += 1; }
 
-    void Tank::resetCantShoot() { cantShoot = 0; }
+    void Tank::resetCantShoot() { store.cantShoot[index] = 0; }
 
-    bool Tank::canShoot() { return artilleryShells > 0 && cantShoot == 0; }
+    bool Tank::canShoot() { return store.artilleryShells[index] > 0 && store.cantShoot[index] == 0; }
 
-    int Tank::getCantShoot() { return cantShoot; }
+    int Tank::getCantShoot() { return store.cantShoot[index]; }
 
-    int Tank::getReverseCharge() const { return reverseCharge; }
-    bool Tank::isReverseQueued() const { return reverseQueued; }
-    bool Tank::isReverseReady() const { return reverseReady; }
+    int Tank::getReverseCharge() const { return store.reverseCharge[index]; }
+    bool Tank::isReverseQueued() const { return store.reverseQueued[index]; }
+    bool Tank::isReverseReady() const { return store.reverseReady[index]; }
 
     void Tank::queueReverse()
     {
-        reverseQueued = true;
-        reverseCharge = 1;
+        store.reverseQueued[index] = true;
+        store.reverseCharge[index] = 1;
     }
 
     void Tank::incrementReverseCharge()
     {
-        if (reverseCharge < 5)
-            reverseCharge++;
+        if (store.reverseCharge[index] < 5)
+            store.reverseCharge[index]++;
         else
-            reverseReady = true;
+            store.reverseReady[index] = true;
     }
 
     void Tank::resetReverseState()
     {
-        reverseQueued = false;
-        reverseCharge = 0;
-        reverseReady = false;
+        store.reverseQueued[index] = false;
+        store.reverseCharge[index] = 0;
+        store.reverseReady[index] = false;
     }
 
     void Tank::executeReverse()
     {
         moveBackwards();
-        reverseQueued = false;
-        reverseCharge = 0;
+        store.reverseQueued[index] = false;
+        store.reverseCharge[index] = 0;
         setLastMove(ActionRequest::MoveBackward);
-        reverseReady = true;
+        store.reverseReady[index] = true;
     }
 
     TankAlgorithm *Tank::getTankAlgorithm()
     {
-        return this->tankAlgorithm.get();
+        return store.algorithms[index].get();
     }
 
     void Tank::setTankAlgorithm(std::unique_ptr<TankAlgorithm> algorithm)
     {
-        this->tankAlgorithm = std::move(algorithm);
+        store.algorithms[index] = std::move(algorithm);
     }
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+// Regression test for GameManager::snapshot / restore / fork.
+// A game restored from its own snapshot after every round, or forked mid-game, must play on exactly
+// like the straight run; a truncated or corrupted snapshot must throw and leave the engine as it was.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "common/GameManagerRegistration.h"
+#include "GameManager.h"
+
+// the plugin registers itself with the Simulator, which is not linked in here
+GameManagerRegistration::GameManagerRegistration(GameManagerFactory) {}
+
+namespace
+{
+    using namespace GameManager_212788293_212497127;
+
+    const std::vector<std::string> MAP = {
+        "################",
+        "#1   @     #  2#",
+        "#  ##   ##    ##",
+        "#1    #      2 #",
+        "#   @    @     #",
+        "# ##   #   ##  #",
+        "#2          1  #",
+        "#    ###       #",
+        "#  @        @  #",
+        "################",
+    };
+    constexpr size_t MAX_STEPS = 120;
+    constexpr size_t NUM_SHELLS = 6;
+    // a game whose snapshot was corrupted into a longer one is cut off here
+    constexpr int MAX_ROUNDS = 1000;
+
+    int failures = 0;
+
+    void check(bool ok, const std::string &what)
+    {
+        if (!ok)
+        {
+            ++failures;
+            std::cerr << "FAILED: " << what << '\n';
+        }
+    }
+
+    // ------------------------ scripted players ------------------------
+    // The tanks keep no state of their own: the action is a hash of the tank and of the round the
+    // driver is about to play, so a restored or forked game is handed the same moves.
+
+    int currentRound = 0;
+
+    class ScriptedTank : public TankAlgorithm
+    {
+    private:
+        int player;
+        int tank;
+
+    public:
+        ScriptedTank(int player, int tank) : player(player), tank(tank) {}
+
+        ActionRequest getAction() override
+        {
+            std::uint32_t h = static_cast<std::uint32_t>(player) * 73856093u ^ static_cast<std::uint32_t>(tank) * 19349663u ^
+                              static_cast<std::uint32_t>(currentRound) * 83492791u;
+            h ^= h >> 13;
+            h *= 0x5bd1e995u;
+            h ^= h >> 15;
+            return static_cast<ActionRequest>(h % 9);
+        }
+
+        void updateBattleInfo(BattleInfo &) override {}
+    };
+
+    class IdlePlayer : public Player
+    {
+    public:
+        void updateTankWithBattleInfo(TankAlgorithm &, SatelliteView &) override {}
+    };
+
+    class MapView : public SatelliteView
+    {
+    public:
+        char getObjectAt(size_t x, size_t y) const override
+        {
+            return y < MAP.size() && x < MAP[y].size() ? MAP[y][x] : '&';
+        }
+    };
+
+    struct Game
+    {
+        MapView map;
+        IdlePlayer player1, player2;
+        TankAlgorithmFactory factory = [](int player, int tank)
+        { return std::make_unique<ScriptedTank>(player, tank); };
+        GameManager gm{false};
+
+        bool start()
+        {
+            return gm.startGame(MAP[0].size(), MAP.size(), map, "snapshot_test", MAX_STEPS, NUM_SHELLS,
+                                player1, "player1", player2, "player2", factory, factory);
+        }
+
+        void attach(GameManager &engine)
+        {
+            engine.attachPlayers(player1, player2, factory, factory);
+        }
+    };
+
+    // ------------------------ helpers ------------------------
+
+    std::vector<std::uint8_t> bytesOf(const GameSnapshot &snapshot)
+    {
+        return std::vector<std::uint8_t>(snapshot.data(), snapshot.data() + snapshot.size());
+    }
+
+    // the snapshot bytes without the wall-clock time played, which differs from run to run
+    std::vector<std::uint8_t> stateOf(const GameSnapshot &snapshot)
+    {
+        SnapshotReader in(snapshot);
+        in.get<std::uint32_t>();
+        for (int field = 0; field < 12; ++field)
+            in.get<std::int32_t>();
+        std::vector<TankMoveRecord> moves;
+        in.getVector(moves);
+        std::vector<std::uint8_t> bytes = bytesOf(snapshot);
+        const size_t playTime = snapshot.size() - in.remaining();
+        std::fill(bytes.begin() + playTime, bytes.begin() + playTime + sizeof(std::int64_t), 0);
+        return bytes;
+    }
+
+    bool sameResult(const GameResult &a, const GameResult &b)
+    {
+        return a.winner == b.winner && a.reason == b.reason && a.rounds == b.rounds &&
+               a.remaining_tanks == b.remaining_tanks;
+    }
+
+    // plays the engine to the end from round `round`, returns the number of rounds it took
+    int playOut(GameManager &gm, int round)
+    {
+        for (bool over = false; !over && round < MAX_ROUNDS; ++round)
+        {
+            currentRound = round;
+            over = gm.playStep();
+        }
+        return round;
+    }
+
+    // ------------------------ tests ------------------------
+
+    // the straight run: the state after each round, states[0] being the one before round 0
+    GameResult straightRun(std::vector<GameSnapshot> &states)
+    {
+        Game game;
+        check(game.start(), "the test map starts a game");
+        states.push_back(game.gm.snapshot());
+        for (bool over = false; !over;)
+        {
+            currentRound = static_cast<int>(states.size()) - 1;
+            over = game.gm.playStep();
+            states.push_back(game.gm.snapshot());
+        }
+        return game.gm.collectResult(true);
+    }
+
+    void restoreEveryRound(const std::vector<GameSnapshot> &states, const GameResult &expected)
+    {
+        Game game;
+        game.start();
+        size_t round = 0;
+        for (bool over = false; !over;)
+        {
+            currentRound = static_cast<int>(round);
+            over = game.gm.playStep();
+            ++round;
+            const GameSnapshot taken = game.gm.snapshot();
+            game.gm.restore(taken);
+            check(bytesOf(game.gm.snapshot()) == bytesOf(taken), "restore(snapshot()) round trips after round " + std::to_string(round));
+            check(round < states.size() && stateOf(taken) == stateOf(states[round]),
+                  "restored run matches the straight run after round " + std::to_string(round));
+            if (round >= states.size())
+                return;
+        }
+        check(round + 1 == states.size(), "restored run ends on the same round");
+        check(sameResult(game.gm.collectResult(true), expected), "restored run has the same result");
+    }
+
+    void forkEveryFewRounds(const std::vector<GameSnapshot> &states, const GameResult &expected)
+    {
+        Game game;
+        game.start();
+        for (int round = 0; round + 1 < static_cast<int>(states.size()); ++round)
+        {
+            if (round % 7 == 0)
+            {
+                std::unique_ptr<GameManager> forked = game.gm.fork();
+                game.attach(*forked);
+                const int end = playOut(*forked, round);
+                check(end + 1 == static_cast<int>(states.size()), "fork at round " + std::to_string(round) + " ends on the same round");
+                check(stateOf(forked->snapshot()) == stateOf(states.back()),
+                      "fork at round " + std::to_string(round) + " ends in the same state");
+                check(sameResult(forked->collectResult(true), expected), "fork at round " + std::to_string(round) + " has the same result");
+            }
+            currentRound = round;
+            game.gm.playStep();
+        }
+    }
+
+    void truncatedSnapshots(const std::vector<GameSnapshot> &states)
+    {
+        const GameSnapshot &mid = states[states.size() / 2];
+        Game game;
+        game.start();
+        for (currentRound = 0; currentRound < 3; ++currentRound)
+            game.gm.playStep();
+        const std::vector<std::uint8_t> before = bytesOf(game.gm.snapshot());
+        for (size_t length = 0; length < mid.size(); ++length)
+        {
+            bool threw = false;
+            try
+            {
+                game.gm.restore(GameSnapshot::fromBytes(mid.data(), length));
+            }
+            catch (const std::runtime_error &)
+            {
+                threw = true;
+            }
+            check(threw, "a snapshot cut to " + std::to_string(length) + " bytes is rejected");
+            check(bytesOf(game.gm.snapshot()) == before, "a rejected snapshot leaves the engine untouched");
+        }
+    }
+
+    // every single-byte corruption either throws, leaving the engine as it was, or restores a
+    // game that plays out; under a sanitizer this is where out-of-range writes show up
+    void corruptedSnapshots(const std::vector<GameSnapshot> &states)
+    {
+        const GameSnapshot &mid = states[states.size() / 2];
+        Game game;
+        game.start();
+        for (size_t at = 0; at < mid.size(); ++at)
+        {
+            for (std::uint8_t flip : {0x01, 0x80, 0xFF})
+            {
+                std::vector<std::uint8_t> bytes = bytesOf(mid);
+                bytes[at] ^= flip;
+                const std::vector<std::uint8_t> before = bytesOf(game.gm.snapshot());
+                try
+                {
+                    game.gm.restore(GameSnapshot(std::move(bytes)));
+                }
+                catch (const std::runtime_error &)
+                {
+                    check(bytesOf(game.gm.snapshot()) == before, "a rejected snapshot leaves the engine untouched");
+                    continue;
+                }
+                game.attach(game.gm);
+                playOut(game.gm, 0);
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::vector<GameSnapshot> states;
+    const GameResult expected = straightRun(states);
+    check(states.size() > 10, "the test game lasts more than a few rounds");
+
+    restoreEveryRound(states, expected);
+    forkEveryFewRounds(states, expected);
+    truncatedSnapshots(states);
+    corruptedSnapshots(states);
+
+    if (failures > 0)
+    {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "snapshot test: " << states.size() - 1 << " rounds, all checks passed\n";
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "ReplayReader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "common/ActionRequest.h"
+#include "UserCommon/DirectionUtils.h"
+#include "UserCommon/Replay.h"
+
+namespace fs = std::filesystem;
+namespace UC = UserCommon_212788293_212497127;
+
+ReplayReader::ReplayReader(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("cannot open replay: " + path);
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void ReplayReader::require(size_t bytes) const
+{
+    if (data.size() - pos < bytes)
+        throw std::runtime_error("replay is truncated");
+}
+
+std::string ReplayReader::getString()
+{
+    size_t length = get<std::uint16_t>();
+    require(length);
+    std::string value(reinterpret_cast<const char *>(data.data() + pos), length);
+    pos += length;
+    return value;
+}
+
+void ReplayReader::getChars(std::vector<char> &out, size_t count)
+{
+    require(count);
+    out.assign(data.begin() + pos, data.begin() + pos + count);
+    pos += count;
+}
+
+ReplayHeader ReplayReader::getHeader()
+{
+    for (char expected : UC::Replay::MAGIC)
+    {
+        if (get<char>() != expected)
+            throw std::runtime_error("not a replay file");
+    }
+    if (get<std::uint16_t>() != UC::Replay::VERSION)
+        throw std::runtime_error("unsupported replay version");
+
+    ReplayHeader header;
+    header.width = get<std::uint16_t>();
+    header.height = get<std::uint16_t>();
+    header.maxSteps = static_cast<int>(get<std::uint32_t>());
+    header.numShells = static_cast<int>(get<std::uint32_t>());
+    header.tankCount = get<std::uint16_t>();
+    header.keyframeInterval = get<std::uint16_t>();
+    header.gameManager = getString();
+    header.mapName = getString();
+    header.player1 = getString();
+    header.player2 = getString();
+    getChars(header.initialFrame, static_cast<size_t>(header.width) * header.height);
+    return header;
+}
+
+// ------------------------ rendering ------------------------
+
+namespace
+{
+    void writeMoves(std::ofstream &moves, ReplayReader &reader, int tankCount)
+    {
+        for (int i = 0; i < tankCount; ++i)
+        {
+            reader.get<std::uint8_t>(); // requested action, not part of the text output
+            std::uint8_t outcome = reader.get<std::uint8_t>();
+            if (outcome & UC::Replay::DEAD)
+                moves << "killed";
+            else
+            {
+                if (outcome & UC::Replay::RECORDED)
+                    moves << UC::to_string(static_cast<ActionRequest>(outcome & UC::Replay::ACTION_MASK));
+                else
+                    moves << ' ';
+                if (outcome & UC::Replay::IGNORED)
+                    moves << " (ignored)";
+                if (outcome & UC::Replay::KILLED)
+                    moves << " (killed)";
+            }
+            if (i != tankCount - 1)
+                moves << ", ";
+        }
+        moves << "\n";
+    }
+
+    void applyFrame(std::vector<char> &frame, ReplayReader &reader)
+    {
+        std::uint8_t kind = reader.get<std::uint8_t>();
+        if (kind == UC::Replay::KEY_FRAME)
+        {
+            size_t size = frame.size();
+            reader.getChars(frame, size);
+        }
+        else if (kind == UC::Replay::DELTA_FRAME)
+        {
+            std::uint32_t count = reader.get<std::uint32_t>();
+            for (std::uint32_t k = 0; k < count; ++k)
+            {
+                std::uint32_t cell = reader.get<std::uint32_t>();
+                char symbol = reader.get<char>();
+                if (cell >= frame.size())
+                    throw std::runtime_error("replay frame cell out of range");
+                frame[cell] = symbol;
+            }
+        }
+        else
+            throw std::runtime_error("unknown replay frame kind");
+    }
+
+    void writeFrame(std::ofstream &viz, const std::vector<char> &frame, int width, int height, std::uint32_t step)
+    {
+        viz << "\n=== Game Step " << step << " ===\n";
+        for (int y = 0; y < height; ++y)
+        {
+            viz.write(frame.data() + static_cast<size_t>(y) * width, width);
+            viz << '\n';
+        }
+        viz << std::endl;
+    }
+}
+
+void renderReplay(const std::string &replayPath, const std::string &outDir)
+{
+    ReplayReader reader(replayPath);
+    ReplayHeader header = reader.getHeader();
+
+    const std::string stem = fs::path(replayPath).stem().string();
+    const fs::path verboseDir = fs::path(outDir) / "verbose";
+    const fs::path visualizationDir = fs::path(outDir) / "visualization";
+    fs::create_directories(verboseDir);
+    fs::create_directories(visualizationDir);
+    std::ofstream moves(verboseDir / (stem + ".moves.txt"), std::ios::out | std::ios::trunc);
+    std::ofstream viz(visualizationDir / (stem + ".viz.txt"), std::ios::out | std::ios::trunc);
+
+    std::vector<char> frame = header.initialFrame;
+    while (!reader.atEnd())
+    {
+        std::uint8_t tag = reader.get<std::uint8_t>();
+        if (tag == UC::Replay::STEP_RECORD)
+        {
+            std::uint32_t step = reader.get<std::uint32_t>();
+            writeMoves(moves, reader, header.tankCount);
+            applyFrame(frame, reader);
+            writeFrame(viz, frame, header.width, header.height, step);
+        }
+        else if (tag == UC::Replay::END_RECORD)
+        {
+            int winner = reader.get<std::int32_t>();
+            int reason = reader.get<std::uint8_t>();
+            std::uint32_t rounds = reader.get<std::uint32_t>();
+            std::uint32_t left1 = reader.get<std::uint32_t>();
+            std::uint32_t left2 = reader.get<std::uint32_t>();
+            moves << "Summary: winner=" << winner << " reason=" << reason
+                  << " total game steps=" << rounds
+                  << " player1 remaining tanks= " << left1
+                  << " player2 remaining tanks= " << left2 << std::endl;
+            return;
+        }
+        else
+            throw std::runtime_error("unknown replay record");
+    }
+    throw std::runtime_error("replay has no end record (game interrupted?)");
+}
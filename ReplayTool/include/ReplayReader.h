@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct ReplayHeader
+{
+    int width{};
+    int height{};
+    int maxSteps{};
+    int numShells{};
+    int tankCount{};
+    int keyframeInterval{};
+    std::string gameManager;
+    std::string mapName;
+    std::string player1;
+    std::string player2;
+    std::vector<char> initialFrame;
+};
+
+// ========================= CLASS: ReplayReader =========================
+// Sequential reader over a replay file loaded in memory, throws std::runtime_error on
+// truncated or malformed input.
+
+class ReplayReader
+{
+private:
+    std::vector<std::uint8_t> data;
+    size_t pos{};
+
+    void require(size_t bytes) const;
+
+public:
+    explicit ReplayReader(const std::string &path);
+
+    bool atEnd() const { return pos >= data.size(); }
+
+    template <typename T>
+    T get()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string getString();
+    void getChars(std::vector<char> &out, size_t count);
+    ReplayHeader getHeader();
+};
+
+// Writes <out_dir>/verbose/<stem>.moves.txt and <out_dir>/visualization/<stem>.viz.txt
+void renderReplay(const std::string &replayPath, const std::string &outDir);
@@ -0,0 +1,39 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ReplayReader.h"
+
+int main(int argc, char **argv)
+{
+    std::string outDir = ".";
+    std::vector<std::string> replays;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg.rfind("out=", 0) == 0)
+            outDir = arg.substr(4);
+        else
+            replays.push_back(arg);
+    }
+    if (replays.empty())
+    {
+        std::cerr << "Usage: replay_render_212788293_212497127 <file.replay>... [out=<dir>]\n"
+                  << "  writes <dir>/verbose/<name>.moves.txt and <dir>/visualization/<name>.viz.txt\n";
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto &path : replays)
+    {
+        try
+        {
+            renderReplay(path, outDir);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << path << ": " << e.what() << "\n";
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -1,5 +1,8 @@
 #include "AbstractMode.h"
 
+#include <cstring>
+#include <limits>
+
 std::string AbstractMode::unique_time_str()
 {
     using namespace std::chrono;
@@ -8,10 +11,40 @@ std::string AbstractMode::unique_time_str()
     return std::to_string(ms);
 }
 
-static inline void chomp_cr(std::string &s)
+const char *reasonName(GameResult::Reason reason, UC::Timeout timeout)
+{
+    if (timeout != UC::Timeout::None)
+        return UC::timeoutName(timeout);
+    switch (reason)
+    {
+    case GameResult::ALL_TANKS_DEAD:
+        return "ALL_TANKS_DEAD";
+    case GameResult::MAX_STEPS:
+        return "MAX_STEPS";
+    case GameResult::ZERO_SHELLS:
+        return "ZERO_SHELLS";
+    }
+    return "UNKNOWN";
+}
+
+void AbstractMode::recordFailedGame(const GameArgs &g, const std::string &why)
+{
+    std::string line = g.map_name + ": " + g.player1Name + " vs " + g.player2Name + " on " + g.GameManagerName + ": " + why;
+    std::cerr << ("Failed: " + line + "\n");
+    std::lock_guard<std::mutex> lk(failed_mtx);
+    failedGames.push_back(std::move(line));
+}
+
+void AbstractMode::writeFailedGames(std::ostream &out)
 {
-    if (!s.empty() && s.back() == '\r')
-        s.pop_back();
+    std::lock_guard<std::mutex> lk(failed_mtx);
+    if (failedGames.empty())
+        return;
+    // completion order depends on scheduling, sorting keeps the file reproducible
+    std::sort(failedGames.begin(), failedGames.end());
+    out << "\nFailed games: " << failedGames.size() << "\n";
+    for (const std::string &line : failedGames)
+        out << line << "\n";
 }
 
 static void fail(const std::string &msg, const std::string &filename)
@@ -19,34 +52,74 @@ static void fail(const std::string &msg, const std::string &filename)
     throw std::runtime_error("Invalid map \"" + filename + "\": " + msg);
 }
 
-static void readTheGrid(std::string filename, std::ifstream &file, size_t map_height, size_t map_width,
-                        std::set<std::pair<size_t, size_t>> &walls,
-                        std::set<std::pair<size_t, size_t>> &mines,
-                        std::set<std::pair<size_t, size_t>> &player1tanks,
-                        std::set<std::pair<size_t, size_t>> &player2tanks)
+namespace
 {
-    std::string line;
-    auto is_allowed = [](char c)
+    // Lines of a map file in place, split like std::getline and with one trailing '\r'
+    // dropped; the map text is never copied line by line.
+    class LineReader
     {
-        return c == ' ' || c == '#' || c == '@' || c == '1' || c == '2';
+    public:
+        LineReader(const char *data, size_t size) : pos(data), end(data + size) {}
+
+        // false at the end of the data, like a failed std::getline
+        bool next(const char *&line, size_t &length)
+        {
+            if (pos == end)
+                return false;
+            const char *eol = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+            const char *stop = eol ? eol : end;
+            line = pos;
+            length = stop - pos;
+            if (length > 0 && line[length - 1] == '\r')
+                --length;
+            pos = eol ? eol + 1 : end;
+            return true;
+        }
+
+    private:
+        const char *pos;
+        const char *end;
     };
 
-    // Lines 6+: map
-    for (size_t row = 0; row < map_height; ++row)
+    // whitespace as matched by \s
+    bool isSpace(char c)
     {
-        if (!std::getline(file, line))
-            line.clear();
-        chomp_cr(line);
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
 
-        // Ignore extra columns beyond map_width, per spec
-        if (line.size() < map_width)
-            line.append(map_width - line.size(), ' ');
+    struct SymbolTable
+    {
+        bool allowed[256]{};
+        SymbolTable()
+        {
+            for (unsigned char c : {' ', '#', '@', '1', '2'})
+                allowed[c] = true;
+        }
+    };
+    const SymbolTable symbols;
+}
+
+static void readTheGrid(const std::string &filename, LineReader &lines, size_t map_height, size_t map_width,
+                        std::vector<char> &cells)
+{
+    cells.assign(map_width * map_height, ' ');
 
-        for (size_t col = 0; col < map_width; ++col)
+    // Lines 6+: map
+    for (size_t row = 0; row < map_height; ++row)
+    {
+        // a missing line is an empty row
+        const char *line = nullptr;
+        size_t length = 0;
+        if (!lines.next(line, length))
+            length = 0;
+
+        // Ignore extra columns beyond map_width, per spec; short lines are padded with spaces
+        const size_t used = std::min(length, map_width);
+        for (size_t col = 0; col < used; ++col)
         {
             char c = line[col];
 
-            if (!is_allowed(c))
+            if (!symbols.allowed[static_cast<unsigned char>(c)])
             {
                 std::ostringstream oss;
                 oss << "Invalid character '"
@@ -57,83 +130,81 @@ static void readTheGrid(std::string filename, std::ifstream &file, size_t map_he
                     << "). Allowed: space, '#', '@', '1', '2'.";
                 fail(oss.str(), filename);
             }
-
-            // Non-strict: treat any other char as empty space (spec-compliant)
-
-            switch (c)
-            {
-            case '#':
-                walls.insert({col, row});
-                break;
-            case '@':
-                mines.insert({col, row});
-                break;
-            case '1':
-                player1tanks.insert({col, row});
-                break;
-            case '2':
-                player2tanks.insert({col, row});
-                break;
-            default: /* empty */
-                break;
-            }
         }
+        std::memcpy(cells.data() + row * map_width, line, used);
     }
 }
 
-static size_t getParams(std::ifstream &file, const std::string &expected_key, const std::string &filename)
+// "<key> = <digits>", case-insensitive key, whitespace allowed around every token
+static size_t getParams(LineReader &lines, const std::string &expected_key, const std::string &filename)
 {
-    std::string line;
-    if (!std::getline(file, line))
+    const char *line = nullptr;
+    size_t length = 0;
+    if (!lines.next(line, length))
         fail("Missing line for " + expected_key + ".", filename);
-    chomp_cr(line);
 
-    const std::string pattern = "^\\s*" + expected_key + "\\s*=\\s*([0-9]+)\\s*$";
-    std::regex re(pattern, std::regex::icase);
-    std::smatch m;
-    if (!std::regex_match(line, m, re))
-        fail("Invalid line for " + expected_key + ": " + line, filename);
+    const char *p = line, *end = line + length;
+    auto invalid = [&]()
+    { fail("Invalid line for " + expected_key + ": " + std::string(line, length), filename); };
 
-    try
+    while (p < end && isSpace(*p))
+        ++p;
+    for (char k : expected_key)
     {
-        return static_cast<size_t>(std::stoul(m[1].str()));
+        if (p == end || std::tolower(static_cast<unsigned char>(*p)) != std::tolower(static_cast<unsigned char>(k)))
+            invalid();
+        ++p;
     }
-    catch (const std::exception &)
+    while (p < end && isSpace(*p))
+        ++p;
+    if (p == end || *p != '=')
+        invalid();
+    ++p;
+    while (p < end && isSpace(*p))
+        ++p;
+    const char *digits = p;
+    while (p < end && *p >= '0' && *p <= '9')
+        ++p;
+    const char *digitsEnd = p;
+    while (p < end && isSpace(*p))
+        ++p;
+    if (digits == digitsEnd || p != end)
+        invalid();
+
+    size_t value = 0;
+    for (const char *d = digits; d < digitsEnd; ++d)
     {
-        fail("Invalid number for " + expected_key + ": " + m[1].str(), filename);
+        const size_t digit = static_cast<size_t>(*d - '0');
+        if (value > (std::numeric_limits<size_t>::max() - digit) / 10)
+            fail("Invalid number for " + expected_key + ": " + std::string(digits, digitsEnd), filename);
+        value = value * 10 + digit;
     }
-    return 0;
+    return value;
 }
 
-ParsedMap AbstractMode::parseBattlefieldFile(const std::string &filename)
+ParsedMap parseBattlefield(const char *data, size_t size, const std::string &filename)
 {
     ParsedMap parsed;
-    std::ifstream file(filename);
-    if (!file)
-        throw std::runtime_error("Cannot open map file: " + filename);
-
-    std::string line;
-    if (!std::getline(file, line))
+    LineReader lines(data, size);
+    const char *line = nullptr;
+    size_t length = 0;
+    if (!lines.next(line, length))
         fail("Missing line 1 (map name/description).", filename);
-    chomp_cr(line);
-    // parsed.map_name = line; // if you keep the name
+    // line 1 is the map name / description, not used
 
     // Use the spec’d keys (case-insensitive due to getParams above)
-    parsed.max_steps = getParams(file, "MaxSteps", filename);
-    parsed.num_shells = getParams(file, "NumShells", filename);
+    parsed.max_steps = getParams(lines, "MaxSteps", filename);
+    parsed.num_shells = getParams(lines, "NumShells", filename);
 
-    parsed.map_height = getParams(file, "Rows", filename);
+    parsed.map_height = getParams(lines, "Rows", filename);
     if (parsed.map_height == 0)
         fail("Rows must be >= 1.", filename);
 
-    parsed.map_width = getParams(file, "Cols", filename);
+    parsed.map_width = getParams(lines, "Cols", filename);
     if (parsed.map_width == 0)
         fail("Cols must be >= 1.", filename);
 
-    readTheGrid(
-        filename, file,
-        parsed.map_height, parsed.map_width, parsed.walls, parsed.mines,
-        parsed.player1tanks, parsed.player2tanks);
+    readTheGrid(filename, lines, parsed.map_height, parsed.map_width, parsed.cells);
 
     return parsed;
 }
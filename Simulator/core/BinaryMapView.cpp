@@ -0,0 +1,129 @@
+#include "BinaryMapView.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace BM = UserCommon_212788293_212497127::BinaryMap;
+
+namespace {
+    [[noreturn]] void invalid(const std::string& path, const std::string& msg) {
+        throw std::runtime_error("Invalid binary map \"" + path + "\": " + msg);
+    }
+
+    // whether both nibbles of a grid byte are valid cell codes, and how many of them are tanks
+    struct ByteTable {
+        bool valid[256]{};
+        std::uint8_t tanks[256]{};
+        ByteTable() {
+            auto isTank = [](unsigned code) { return BM::SYMBOLS[code] == '1' || BM::SYMBOLS[code] == '2'; };
+            for (unsigned b = 0; b < 256; ++b) {
+                valid[b] = (b & 0x0F) < BM::CODE_COUNT && (b >> 4) < BM::CODE_COUNT;
+                if (valid[b]) tanks[b] = static_cast<std::uint8_t>(isTank(b & 0x0F) + isTank(b >> 4));
+            }
+        }
+    };
+    const ByteTable bytes;
+}
+
+BinaryMapView::BinaryMapView(std::unique_ptr<MappedFile> file, size_t width, size_t height)
+    : file(std::move(file)), width(width), height(height) {
+    grid = reinterpret_cast<const std::uint8_t*>(this->file->data()) + sizeof(BM::Header);
+}
+
+char BinaryMapView::getObjectAt(size_t x, size_t y) const {
+    if (x >= width || y >= height) return ' '; // Empty space
+    return BM::cellAt(grid, y * width + x);
+}
+
+void BinaryMapView::copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const {
+    for (size_t row = 0; row < h; ++row) {
+        const size_t first = (y + row) * width + x;
+        char* dst = out + row * stride;
+        for (size_t col = 0; col < w; ++col) dst[col] = BM::cellAt(grid, first + col);
+    }
+}
+
+bool isBinaryMapPath(const std::string &path) {
+    return std::filesystem::path(path).extension() == BM::EXTENSION;
+}
+
+std::vector<std::string> preferBinaryMaps(const std::vector<std::string> &files) {
+    std::set<std::filesystem::path> binary;
+    for (const std::string& f : files) {
+        if (isBinaryMapPath(f)) binary.insert(std::filesystem::path(f).replace_extension());
+    }
+    std::vector<std::string> maps;
+    for (const std::string& f : files) {
+        if (isBinaryMapPath(f) || !binary.count(std::filesystem::path(f).replace_extension())) maps.push_back(f);
+    }
+    return maps;
+}
+
+std::shared_ptr<const GameMap> loadBinaryMap(const std::string &path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path)) throw std::runtime_error("Cannot open map file: " + path);
+    if (file->size() < sizeof(BM::Header)) invalid(path, "file too short for the header.");
+
+    BM::Header header;
+    std::memcpy(&header, file->data(), sizeof header);
+    if (std::memcmp(header.magic, BM::MAGIC, sizeof BM::MAGIC) != 0) invalid(path, "not a binary map.");
+    if (header.version != BM::VERSION) invalid(path, "unsupported version " + std::to_string(header.version) + ".");
+    if (header.height == 0) invalid(path, "Rows must be >= 1.");
+    if (header.width == 0) invalid(path, "Cols must be >= 1.");
+
+    const size_t gridSize = BM::gridBytes(header.width, header.height);
+    if (file->size() != sizeof(BM::Header) + gridSize)
+        invalid(path, "size " + std::to_string(file->size()) + " does not match a " + std::to_string(header.width) + "x" + std::to_string(header.height) + " grid.");
+
+    const auto* grid = reinterpret_cast<const std::uint8_t*>(file->data()) + sizeof(BM::Header);
+    if (BM::checksum(grid, gridSize) != header.checksum) invalid(path, "checksum mismatch.");
+    size_t tanks = 0;
+    for (size_t i = 0; i < gridSize; ++i) {
+        if (!bytes.valid[grid[i]]) invalid(path, "invalid cell code at byte " + std::to_string(i) + ".");
+        tanks += bytes.tanks[grid[i]];
+    }
+
+    auto view = std::make_shared<const BinaryMapView>(std::move(file), header.width, header.height);
+    return std::make_shared<const GameMap>(GameMap{ header.width, header.height, header.maxSteps, header.numShells, std::move(view), tanks });
+}
+
+bool writeBinaryMap(const std::string &path, const GameMap &map, std::string &err) {
+    if (map.map_width > UINT32_MAX || map.map_height > UINT32_MAX) { err = "map too large for the binary format"; return false; }
+
+    const size_t cells = map.map_width * map.map_height;
+    std::vector<char> symbols(cells);
+    UserCommon_212788293_212497127::copySatellite(*map.view, map.map_width, map.map_height, symbols.data());
+    std::vector<std::uint8_t> grid(BM::gridBytes(map.map_width, map.map_height), 0);
+    for (size_t i = 0; i < cells; ++i) {
+        const std::uint8_t code = BM::codeOf(symbols[i]);
+        if (code == BM::CODE_COUNT) { err = "cell " + std::to_string(i) + " holds '" + std::string(1, symbols[i]) + "'"; return false; }
+        grid[i / 2] |= (i & 1) ? static_cast<std::uint8_t>(code << 4) : code;
+    }
+
+    BM::Header header{};
+    std::memcpy(header.magic, BM::MAGIC, sizeof BM::MAGIC);
+    header.version = BM::VERSION;
+    header.width = static_cast<std::uint32_t>(map.map_width);
+    header.height = static_cast<std::uint32_t>(map.map_height);
+    header.maxSteps = map.max_steps;
+    header.numShells = map.num_shells;
+    header.checksum = BM::checksum(grid.data(), grid.size());
+
+    // written aside and renamed: a Simulator that has the old file mapped keeps reading it, and
+    // concurrent readers never see half a map
+    const std::string tmp = path + ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);
+    out.write(reinterpret_cast<const char*>(grid.data()), static_cast<std::streamsize>(grid.size()));
+    out.close();
+    std::error_code ec;
+    if (!out) { err = "cannot write " + tmp; std::filesystem::remove(tmp, ec); return false; }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { err = "cannot replace " + path + ": " + ec.message(); std::filesystem::remove(tmp, ec); return false; }
+    return true;
+}
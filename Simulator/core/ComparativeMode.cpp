@@ -11,18 +11,18 @@ std::vector<GameArgs> ComparativeMode::getAllGames(std::vector<std::string> game
     std::string player1Name = algorithmRegistrar.begin()->second.name();
     std::string player2Name = algorithmRegistrar.rbegin()->second.name();
     try{
-    struct ParsedMap parsedMap = parseBattlefieldFile(game_maps[0]);
+    std::shared_ptr<const GameMap> parsedMap = maps.load(game_maps[0]);
     for (size_t i = 0; i < gameManagerRegistrar.getGameManagerCount(); i++) {
         if(gameManagerRegistrar.gameManagers.count(i)){
         auto& gameManagerFactory = gameManagerRegistrar.getGameManagerFactory(i);
-        auto satellite = std::make_unique<InitialSatellite>( parsedMap.player1tanks, parsedMap.player2tanks, parsedMap.walls, parsedMap.mines);
         if (gameManagerFactory.hasFactory()) 
             games.push_back({
-                parsedMap.map_width,
-                parsedMap.map_height,
-                parsedMap.max_steps,
-                parsedMap.num_shells,
-                std::move(satellite),
+                parsedMap->map_width,
+                parsedMap->map_height,
+                parsedMap->max_steps,
+                parsedMap->num_shells,
+                parsedMap->view,
+                parsedMap->tanks,
                 game_maps[0],
                 gameManagerFactory.name(), 
                 player1Name, 
@@ -117,8 +117,8 @@ int ComparativeMode::registerGameManagers(Cli cli, std::vector<LoadedLib> gmLibs
 
 
 
-void ComparativeMode::applyCompetitionScore(const GameArgs& g, GameResult res, std::string finalGameState) {
-    ComparativeKey key{res.winner, res.reason, res.rounds, finalGameState};
+void ComparativeMode::applyCompetitionScore(const GameArgs& g, RanGame ran) {
+    ComparativeKey key{ran.result.winner, ran.result.reason, ran.result.rounds, std::move(ran.gameFinalState), ran.timeout};
 
     std::lock_guard<std::mutex> lk(clusters_mtx);
               
@@ -132,18 +132,6 @@ void ComparativeMode::applyCompetitionScore(const GameArgs& g, GameResult res, s
 
 
 
-static const char* reasonToStr(GameResult::Reason r) {
-    switch (r) {
-        case GameResult::ALL_TANKS_DEAD: return "ALL_TANKS_DEAD";
-        case GameResult::MAX_STEPS:      return "MAX_STEPS";
-        case GameResult::ZERO_SHELLS:    return "ZERO_SHELLS";
-    }
-    return "UNKNOWN";
-}
-
-
-
-
 static inline std::string basename_of(const std::string& path) {
     const auto p = path.find_last_of("/\\");
     return (p == std::string::npos) ? path : path.substr(p + 1);
@@ -186,7 +174,7 @@ static void printBody(std::ostream& out,
     std::sort(gm_list.begin(), gm_list.end()); 
     out << "---- Group ----\n";
     out << "Winner: " << winnerToStr(key.winner)
-        << "  |  Reason: " << reasonToStr(key.reason)
+        << "  |  Reason: " << reasonName(key.reason, key.timeout)
         << "  |  Rounds: " << key.rounds
         << "  |  GameManagers: " << gm_list.size() << "\n";
 
@@ -214,6 +202,7 @@ static void sortingHelperFunc(std::vector<std::pair<ComparativeKey, std::vector<
         const auto& ka = a.first; const auto& kb = b.first;
         if (ka.winner != kb.winner) return ka.winner < kb.winner;
         if (ka.reason != kb.reason) return static_cast<int>(ka.reason) < static_cast<int>(kb.reason);
+        if (ka.timeout != kb.timeout) return static_cast<int>(ka.timeout) < static_cast<int>(kb.timeout);
         if (ka.rounds != kb.rounds) return ka.rounds < kb.rounds;
         if (a.second.size() != b.second.size()) return a.second.size() > b.second.size();
         return ka.finalBoard < kb.finalBoard;
@@ -245,6 +234,7 @@ void ComparativeMode::writeComparativeResults(const std::string& game_managers_f
     }
     printBody(out, key, gm_list, rep);
     }
+    writeFailedGames(out);
     out.close();
 }
 
@@ -1,5 +1,7 @@
 #include "CompetitionMode.h"
 
+#include <tuple>
+
 std::vector<GameArgs> CompetitionMode::getAllGames(std::vector<std::string> game_maps) {
     std::vector<GameArgs> games;
     auto& gameManagerRegistrar = GameManagerRegistrar::getGameManagerRegistrar();
@@ -12,16 +14,14 @@ std::vector<GameArgs> CompetitionMode::getAllGames(std::vector<std::string> game
     for(int i=0; i<(int)game_maps.size(); i++) {
         std::set<std::pair<size_t, size_t>> assignedGames;
         const auto& game_map = game_maps[i];
-        try{ParsedMap parsedMap = parseBattlefieldFile(game_map);
+        try{std::shared_ptr<const GameMap> parsedMap = maps.load(game_map);
         
         for(size_t j=0; j<algoCount; j++) {
-            auto satellite = std::make_unique<InitialSatellite>(parsedMap.player1tanks, parsedMap.player2tanks, parsedMap.walls, parsedMap.mines);
-
             size_t k = (i+j+1)%(algoCount-1);
             if (k == j) continue; 
             if (assignedGames.count({k, j}) > 0 || assignedGames.count({j, k}) > 0 ) continue; // Skip if already assigned
-            games.push_back({parsedMap.map_width, parsedMap.map_height, parsedMap.max_steps, parsedMap.num_shells,
-                std::move(satellite), 
+            games.push_back({parsedMap->map_width, parsedMap->map_height, parsedMap->max_steps, parsedMap->num_shells,
+                parsedMap->view, parsedMap->tanks,
                 game_map, 
                 gameManagerName, 
                 algorithmRegistrar.getPlayerAndAlgoFactory(k).name(),
@@ -35,6 +35,7 @@ std::vector<GameArgs> CompetitionMode::getAllGames(std::vector<std::string> game
         usage("No valid games could be created. Please check the map files.");
         throw std::runtime_error("No valid games could be created. Please check the map files.");
     }
+    resumeFromJournal(games);
     return games;
 }
 
@@ -98,10 +99,57 @@ void CompetitionMode::add_relaxed(std::atomic<size_t>& x, size_t d) {
     x.fetch_add(d, std::memory_order_relaxed);
 }
 
-void CompetitionMode::applyCompetitionScore(const GameArgs& g, GameResult r, std::string /*finalGameState*/) {
-    const std::string a1 = g.player1Name;
-    const std::string a2 = g.player2Name;
-    switch (r.winner) {
+namespace {
+    using JournalKey = std::tuple<std::string, std::string, std::string, std::string>;
+
+    JournalKey journalKey(const std::string& map, const std::string& gm, const std::string& p1, const std::string& p2) {
+        return { fs::path(map).filename().string(), gm, p1, p2 };
+    }
+}
+
+void CompetitionMode::resumeFromJournal(std::vector<GameArgs>& games) {
+    std::vector<JournalEntry> played;
+    std::string err;
+    if (!journal.open(journalPath, played, err)) {
+        std::cerr << "Note: " << err << " — results are not journaled and cannot be resumed.\n";
+        return;
+    }
+    if (played.empty()) return;
+
+    // a pairing can be listed more than once, each journal entry stands for one of them
+    std::map<JournalKey, std::vector<const JournalEntry*>> byGame;
+    for (const JournalEntry& e : played) byGame[journalKey(e.map, e.gameManager, e.player1, e.player2)].push_back(&e);
+    const size_t total = games.size();
+    std::vector<GameArgs> remaining;
+    for (GameArgs& g : games) {
+        auto it = byGame.find(journalKey(g.map_name, g.GameManagerName, g.player1Name, g.player2Name));
+        if (it == byGame.end() || it->second.empty()) { remaining.push_back(std::move(g)); continue; }
+        applyEntry(*it->second.back());
+        it->second.pop_back();
+        ++resumed;
+    }
+    games = std::move(remaining);
+
+    std::cerr << "Resuming from " << journal.path() << ": " << resumed << " of " << total << " game(s) already played.\n";
+    if (played.size() > resumed) {
+        std::cerr << "Note: " << played.size() - resumed << " journaled game(s) are not part of this competition and do not score.\n";
+    }
+}
+
+void CompetitionMode::applyCompetitionScore(const GameArgs& g, RanGame ran) {
+    JournalEntry e{ fs::path(g.map_name).filename().string(), g.GameManagerName, g.player1Name, g.player2Name,
+                    ran.result.winner, reasonName(ran.result.reason, ran.timeout), ran.result.rounds, ran.seconds };
+    // a game stopped by Ctrl-C is not over: it neither scores nor is journaled, so a resumed run plays it
+    if (ran.timeout == UC::Timeout::Cancelled) return;
+    journal.append(e);
+    applyEntry(e);
+}
+
+void CompetitionMode::applyEntry(const JournalEntry& e) {
+    // a timed-out game already names its winner: the other player on a tank call overrun, else a tie
+    const std::string& a1 = e.player1;
+    const std::string& a2 = e.player2;
+    switch (e.winner) {
         case 1:  add_relaxed(algoNamesAndScores[a1], 3); break;
         case 2:  add_relaxed(algoNamesAndScores[a2], 3); break;
         default: // 0 = tie
@@ -126,6 +174,7 @@ std::vector<std::pair<std::string, size_t>> CompetitionMode::build_sorted_score_
 }
 
 void CompetitionMode::writeCompetitionResults(const std::string& algorithms_folder, const std::string& game_maps_folder, const std::string& game_manager_so){
+    journal.sync(); // the table is only as durable as the games it counts
     const auto table = build_sorted_score_table();
     const std::string filename = "competition_" + unique_time_str() + ".txt";
     const std::string outpath  = (fs::path(algorithms_folder) / filename).string();
@@ -148,6 +197,7 @@ void CompetitionMode::writeCompetitionResults(const std::string& algorithms_fold
     for (const auto& [name, score] : table) {
         (*sink) << name << " " << score << "\n";
         }
+    writeFailedGames(*sink);
 
     if (!to_stdout) {
         out.flush();
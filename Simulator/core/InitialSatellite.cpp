@@ -1,14 +1,18 @@
 #include "InitialSatellite.h"
+#include <algorithm>
 
 char InitialSatellite::getObjectAt(size_t x, size_t y) const
 {
-    if (player1Tanks.count({x, y}))
-        return '1';
-    if (player2Tanks.count({x, y}))
-        return '2';
-    if (walls.count({x, y}))
-        return '#';
-    if (mines.count({x, y}))
-        return '@';
-    return ' '; // Empty space
+    if (x >= width || y >= height)
+        return ' '; // Empty space
+    return cells[y * width + x];
+}
+
+void InitialSatellite::copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const
+{
+    for (size_t row = 0; row < h; ++row)
+    {
+        const char *src = cells.data() + (y + row) * width + x;
+        std::copy(src, src + w, out + row * stride);
+    }
 }
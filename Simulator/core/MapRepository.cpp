@@ -0,0 +1,72 @@
+#include "MapRepository.h"
+#include "AbstractMode.h"
+#include "BinaryMapView.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <iomanip>
+
+namespace {
+    // FNV-1a; only has to tell map files apart, not resist tampering
+    std::uint64_t contentHash(const char* data, size_t size) {
+        std::uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; ++i) { h ^= static_cast<unsigned char>(data[i]); h *= 1099511628211ull; }
+        return h;
+    }
+
+    std::shared_ptr<const GameMap> parseGameMap(const MappedFile& file, const std::string& path) {
+        ParsedMap parsed = parseBattlefield(file.data(), file.size(), path);
+        const size_t tanks = std::count_if(parsed.cells.begin(), parsed.cells.end(), [](char c) { return c == '1' || c == '2'; });
+        auto view = std::make_shared<const InitialSatellite>(parsed.map_width, parsed.map_height, std::move(parsed.cells));
+        return std::make_shared<const GameMap>(GameMap{ parsed.map_width, parsed.map_height, parsed.max_steps, parsed.num_shells, std::move(view), tanks });
+    }
+}
+
+std::shared_ptr<const GameMap> MapRepository::load(const std::string& path) {
+    if (auto it = maps.find(path); it != maps.end()) return it->second;
+
+    std::shared_ptr<const GameMap> map;
+    if (isBinaryMapPath(path)) {
+        map = loadBinaryMap(path);
+        maps.emplace(path, map);
+        return map;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) throw std::runtime_error("Cannot open map file: " + path);
+    if (cacheDir.empty()) {
+        map = parseGameMap(file, path);
+    }
+    else {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << contentHash(file.data(), file.size()) << '-' << std::dec << file.size() << UserCommon_212788293_212497127::BinaryMap::EXTENSION;
+        const std::string cacheFile = (fs::path(cacheDir) / name.str()).string();
+        map = readCache(cacheFile);
+        if (!map) {
+            map = parseGameMap(file, path);
+            writeCache(cacheFile, *map);
+        }
+    }
+    maps.emplace(path, map);
+    return map;
+}
+
+std::shared_ptr<const GameMap> MapRepository::readCache(const std::string& file) const {
+    if (!fs::exists(file)) return nullptr;
+    try {
+        return loadBinaryMap(file);
+    }
+    catch (const std::exception&) {
+        // a damaged entry (e.g. from an interrupted run) is parsed again and rewritten
+        return nullptr;
+    }
+}
+
+void MapRepository::writeCache(const std::string& file, const GameMap& map) const {
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+    // writeBinaryMap replaces the entry atomically, concurrent runs never see half of it
+    std::string err;
+    if (!writeBinaryMap(file, map, err))
+        std::cerr << "Note: cannot write map cache " << file << " (" << err << "), continuing without it.\n";
+}
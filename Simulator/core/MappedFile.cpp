@@ -0,0 +1,48 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { ::close(fd); return false; }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) { ::close(fd); length = 0; return false; }
+        // read front to back exactly once
+        madvise(p, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(p);
+        mapped = true;
+    }
+    ::close(fd); // the mapping keeps the file contents reachable
+    return true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+    mapped = false;
+    bytes = nullptr;
+    length = 0;
+    buffer.clear();
+}
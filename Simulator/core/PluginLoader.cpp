@@ -67,6 +67,9 @@ Cli parse_cli(int argc, char** argv, std::vector<std::string>& bad) {
         if (s=="-comparative") { cli.mode=Cli::Comparative; mode_set=true; continue; }
         if (s=="-competition") { cli.mode=Cli::Competition; mode_set=true; continue; }
         if (s=="-verbose")     { cli.verbose=true; continue; }
+        if (s=="-replay")      { cli.replay=true; continue; }
+        if (s=="-delta_frames"){ cli.deltaFrames=true; continue; }
+        if (s=="-isolated")    { cli.isolated=true; continue; }
         auto eq = s.find('=');
         if (eq!=std::string::npos) {
             auto k = trim(s.substr(0,eq));
@@ -85,9 +88,9 @@ void usage(const std::string& err, const std::vector<std::string>& bad) {
     }
     std::cerr <<
 "Comparative:\n"
-"  ./sim -comparative game_map=<file> game_managers_folder=<dir> algorithm1=<so> algorithm2=<so> [num_threads=<n>] [-verbose]\n"
+"  ./sim -comparative game_map=<file> game_managers_folder=<dir> algorithm1=<so> algorithm2=<so> [num_threads=<n>] [game_time_ms=<n>] [tank_call_ms=<n>] [map_cache=<dir>] [-verbose [-delta_frames]] [-replay] [-isolated]\n"
 "Competition:\n"
-"  ./sim -competition game_maps_folder=<dir> game_manager=<so> algorithms_folder=<dir> [num_threads=<n>] [-verbose]\n";
+"  ./sim -competition game_maps_folder=<dir> game_manager=<so> algorithms_folder=<dir> [num_threads=<n>] [game_time_ms=<n>] [tank_call_ms=<n>] [map_cache=<dir>] [journal=<file>] [-verbose [-delta_frames]] [-replay] [-isolated]\n";
 }
 
 bool file_exists(const std::string& p){ std::error_code ec; return fs::is_regular_file(p,ec); }
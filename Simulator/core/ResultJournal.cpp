@@ -0,0 +1,127 @@
+#include "ResultJournal.h"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+namespace {
+    constexpr const char* HEADER = "# competition journal v1: map game_manager player1 player2 winner reason rounds seconds\n";
+    constexpr const char* MAGIC = "# competition journal v1";
+
+    // tabs and newlines would split the line differently when it is read back
+    std::string field(const std::string& s) {
+        std::string out = s;
+        for (char& c : out) if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+        return out;
+    }
+
+    bool parseEntry(const std::string& line, JournalEntry& e) {
+        std::vector<std::string> f;
+        size_t from = 0;
+        while (true) {
+            const size_t tab = line.find('\t', from);
+            f.push_back(line.substr(from, tab == std::string::npos ? std::string::npos : tab - from));
+            if (tab == std::string::npos) break;
+            from = tab + 1;
+        }
+        if (f.size() != 8) return false;
+        try {
+            size_t used = 0;
+            e = JournalEntry{ f[0], f[1], f[2], f[3], std::stoi(f[4], &used), f[5], 0, 0 };
+            if (used != f[4].size()) return false;
+            e.rounds = std::stoull(f[6], &used);
+            if (used != f[6].size()) return false;
+            e.seconds = std::stod(f[7], &used);
+            return used == f[7].size();
+        }
+        catch (const std::exception&) { return false; }
+    }
+}
+
+ResultJournal::~ResultJournal() {
+    if (!file) return;
+    sync();
+    std::fclose(file);
+}
+
+bool ResultJournal::open(const std::string& path, std::vector<JournalEntry>& existing, std::string& err) {
+    std::string text;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in) text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    // only lines that reached their '\n' count; the rest was cut short and is dropped
+    const size_t complete = text.rfind('\n') == std::string::npos ? 0 : text.rfind('\n') + 1;
+    // anything else must follow our header, or be the start of one whose write was cut short;
+    // a file that is neither is left untouched
+    const bool journalHeader = complete > 0 && text.compare(0, std::strlen(MAGIC), MAGIC) == 0;
+    const bool tornHeader = complete == 0 && std::string(HEADER).compare(0, text.size(), text) == 0;
+    if (!text.empty() && !journalHeader && !tornHeader) {
+        err = "not a competition journal: " + path;
+        return false;
+    }
+    if (complete < text.size()) {
+        std::error_code ec;
+        std::filesystem::resize_file(path, complete, ec);
+        if (ec) { err = "cannot truncate torn journal " + path + ": " + ec.message(); return false; }
+    }
+
+    size_t malformed = 0;
+    for (size_t pos = 0; pos < complete;) {
+        const size_t eol = text.find('\n', pos);
+        const std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        if (line.empty() || line[0] == '#') continue;
+        JournalEntry e;
+        if (parseEntry(line, e)) existing.push_back(std::move(e));
+        else ++malformed;
+    }
+    if (malformed) std::cerr << "Note: skipped " << malformed << " malformed line(s) of journal " << path << "\n";
+
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) { err = "cannot open journal " + path + ": " + std::strerror(errno); return false; }
+    filePath = path;
+    if (complete == 0) {
+        std::fputs(HEADER, file);
+        std::fflush(file);
+    }
+    lastSync = std::chrono::steady_clock::now();
+    return true;
+}
+
+void ResultJournal::append(const JournalEntry& e) {
+    char numbers[96];
+    std::snprintf(numbers, sizeof(numbers), "%d\t%s\t%zu\t%.3f\n", e.winner, field(e.reason).c_str(), e.rounds, e.seconds);
+    const std::string line = field(e.map) + '\t' + field(e.gameManager) + '\t' + field(e.player1) + '\t' + field(e.player2) + '\t' + numbers;
+
+    std::lock_guard<std::mutex> lk(mtx);
+    if (!file) return;
+    // one write per line, flushed at once: the line is in the file even if the process dies next
+    std::fputs(line.c_str(), file);
+    std::fflush(file);
+    if (++unsynced >= SYNC_EVERY || std::chrono::steady_clock::now() - lastSync >= SYNC_INTERVAL) syncLocked();
+}
+
+void ResultJournal::sync() {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (file) syncLocked();
+}
+
+void ResultJournal::syncLocked() {
+    std::fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+    unsynced = 0;
+    lastSync = std::chrono::steady_clock::now();
+}
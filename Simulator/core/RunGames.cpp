@@ -1,5 +1,9 @@
 
 #include "RunGames.h"
+#include "BinaryMapView.h"
+
+#include <csignal>
+#include <cstdio>
 
 
 
@@ -26,9 +30,11 @@ return entry.createPlayer(player_index, x, y, max_steps, num_shells); // unique_
 std::string satelliteViewToString(const SatelliteView& sv, size_t W, size_t H) {
     std::string s;
     s.reserve(H*(W+1));
+    std::vector<char> row(W);
     for (size_t y=0; y<H; ++y) {
+        UC::copySatelliteRow(sv, y, W, row.data());
         for (size_t x=0; x<W; ++x) {
-            char ch = sv.getObjectAt(x,y);
+            char ch = row[x];
             unsigned char u = static_cast<unsigned char>(ch);
             if (ch == '\0' || (u < 32 && ch != '\n' && ch != '\t' && ch != '\r')) ch='.';
             if (ch == ' ') ch = '.';           
@@ -44,59 +50,262 @@ std::string satelliteViewToString(const SatelliteView& sv, size_t W, size_t H) {
 
 
 
-RanGame run_single_game(const GameArgs& g, bool verbose) {
+UC::VerboseOutputStats verboseOutputStats() {
+    // the counters are kept per plugin, any game manager of a plugin reports them
+    UC::VerboseOutputStats total;
+    for (const auto& [id, entry] : GameManagerRegistrar::getGameManagerRegistrar()) {
+        if (!entry.hasFactory()) continue;
+        std::unique_ptr<AbstractGameManager> gm = entry.create(false);
+        if (auto* reporter = dynamic_cast<UC::VerboseOutputReporter*>(gm.get())) total += reporter->getVerboseOutputStats();
+    }
+    return total;
+}
+
+
+void reportVerboseOutput(std::ostream& os, const UC::VerboseOutputStats& s) {
+    if (s.bytesWritten == 0) return;
+    // stalls are time the games waited for the files to be written
+    char line[160];
+    std::snprintf(line, sizeof(line), "Verbose output: %llu bytes in %llu write(s), %llu producer stall(s) (%.1f ms waiting)\n",
+                  static_cast<unsigned long long>(s.bytesWritten), static_cast<unsigned long long>(s.writeCalls),
+                  static_cast<unsigned long long>(s.producerStalls), s.stallMicroseconds / 1000.0);
+    os << line;
+}
+
+
+std::unique_ptr<AbstractGameManager> make_game_manager(const GameArgs& g, const OutputOptions& out, const RunLimits& limits) {
     auto& gmReg = GameManagerRegistrar::getGameManagerRegistrar();
     auto it = gmReg.gameManagers.find(g.GameManagerID);
     if (it == gmReg.gameManagers.end() || !it->second.hasFactory()) {
         throw std::runtime_error("GameManager not found or not loadable: " + g.GameManagerName);
     }
-    std::unique_ptr<AbstractGameManager> gm = it->second.create(verbose);
+    std::unique_ptr<AbstractGameManager> gm = it->second.create(out.verbose);
+    if (out.replay) {
+        if (auto* recorder = dynamic_cast<UC::ReplayRecorder*>(gm.get())) recorder->setReplayDirectory(kReplayDir);
+        else std::cerr << "Note: " << g.GameManagerName << " cannot record replays.\n";
+    }
+    if (out.verbose && out.deltaFrames) {
+        // game managers without the extension keep writing full frames
+        if (auto* selector = dynamic_cast<UC::FrameFormatSelector*>(gm.get())) selector->setFrameFormat(UC::FrameFormat::Delta);
+    }
+    if (auto* budgeted = dynamic_cast<UC::BudgetedGameManager*>(gm.get())) budgeted->setBudget(limits.budget, limits.cancel);
+    else if (limits.budget.game.count() > 0 || limits.budget.tankCall.count() > 0) std::cerr << "Note: " << g.GameManagerName << " does not enforce time budgets.\n";
+    return gm;
+}
+
+
+OutputOptions outputOptions(const Cli& cli) {
+    return OutputOptions{ cli.verbose, cli.replay, cli.deltaFrames };
+}
+
+
+namespace {
+    UC::CancellationToken* interruptToken = nullptr;
+
+    void cancelOnInterrupt(int) {
+        if (interruptToken) interruptToken->cancel();
+    }
+
+    UC::Timeout timeoutOf(AbstractGameManager* gm, size_t game) {
+        auto* budgeted = dynamic_cast<UC::BudgetedGameManager*>(gm);
+        return budgeted ? budgeted->getTimeout(game) : UC::Timeout::None;
+    }
+
+    // a batch game's own time; without the extension, the time since the previous game ended
+    double playSecondsOf(AbstractGameManager* gm, size_t game, double elapsedSeconds) {
+        auto* budgeted = dynamic_cast<UC::BudgetedGameManager*>(gm);
+        return budgeted ? budgeted->getPlayTime(game).count() : elapsedSeconds;
+    }
+
+    void reportTimeout(const RanGame& ran) {
+        if (ran.timeout == UC::Timeout::None) return;
+        // one write per line, so reports of concurrent games do not interleave
+        std::cerr << ("Note: " + ran.map_name + " on " + ran.gm_name + " ended after " + std::to_string(ran.result.rounds)
+                      + " round(s): " + UC::timeoutName(ran.timeout) + "\n");
+    }
+}
+
+
+bool runLimits(Cli& cli, RunLimits& limits) {
+    const std::pair<const char*, std::chrono::milliseconds*> keys[] = {
+        {"game_time_ms", &limits.budget.game}, {"tank_call_ms", &limits.budget.tankCall}};
+    for (const auto& [key, value] : keys) {
+        if (!cli.kv.count(key)) continue;
+        try {
+            const long long ms = std::stoll(cli.kv[key]);
+            if (ms < 0) throw std::out_of_range(key);
+            *value = std::chrono::milliseconds(ms);
+        }
+        catch (...) { usage(std::string(key) + " must be a non-negative integer."); return false; }
+    }
+
+    // SIGINT ends the running games at their next round and skips the rest; results are still written
+    limits.cancel = std::make_shared<UC::CancellationToken>();
+    interruptToken = limits.cancel.get();
+    std::signal(SIGINT, cancelOnInterrupt);
+    return true;
+}
+
+
+RanGame run_single_game(const GameArgs& g, const OutputOptions& out, const RunLimits& limits) {
+    std::unique_ptr<AbstractGameManager> gm = make_game_manager(g, out, limits);
     TankAlgorithmFactory f1 = make_tank_factory(g.playerAndAlgoFactory1ID);
     TankAlgorithmFactory f2 = make_tank_factory(g.playerAndAlgoFactory2ID);
 
     std::unique_ptr<Player> p1 = make_player(g.playerAndAlgoFactory1ID, /*player_index=*/1, g.map_width, g.map_height, g.max_steps, g.num_shells);
     std::unique_ptr<Player> p2 = make_player(g.playerAndAlgoFactory2ID, /*player_index=*/2, g.map_width, g.map_height, g.max_steps, g.num_shells);
   
+    const auto start = std::chrono::steady_clock::now();
     GameResult res = gm->run(
         g.map_width, g.map_height,
-        std::move(*g.map),                      
+        *g.map,
         g.map_name,
         g.max_steps, g.num_shells,
         *p1, g.player1Name, *p2, g.player2Name,
         f1, f2
     );
     std::string gameFinalState = satelliteViewToString(*res.gameState.get() , g.map_width, g.map_height);
-    return RanGame{ g.GameManagerName, g.map_name, g.playerAndAlgoFactory1ID, g.playerAndAlgoFactory2ID, std::move(res), gameFinalState };
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    RanGame ran{ g.GameManagerName, g.map_name, g.playerAndAlgoFactory1ID, g.playerAndAlgoFactory2ID, std::move(res), gameFinalState, timeoutOf(gm.get(), 0), seconds };
+    reportTimeout(ran);
+    return ran;
 }
 
 
-void runThreads(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_threads, bool verbose) {
-    std::atomic<size_t> next{0};
-    const size_t n = jobs.size();    
-    auto worker = [&] {
-        while (true) {
-            size_t i = next.fetch_add(1, std::memory_order_relaxed);
-            if (i >= n) break;
-            RanGame result = run_single_game(jobs[i], verbose); 
-            mode->applyCompetitionScore(jobs[i], std::move(result.result), result.gameFinalState);
+void run_game_batch(const std::vector<GameArgs>& jobs, const GameBatch& batch, const OutputOptions& out, const RunLimits& limits, GameManagerCache& engines,
+                    const GameFinished& finished) {
+    const GameArgs& first = jobs[batch.first];
+    std::unique_ptr<AbstractGameManager>& gm = engines[first.GameManagerID];
+    if (!gm) gm = make_game_manager(first, out, limits);
+
+    auto* batchGm = dynamic_cast<UC::BatchGameManager*>(gm.get());
+    if (!batchGm) {
+        // the game manager only implements the course interface, play each game on a fresh one
+        for (size_t i = batch.first; i < batch.first + batch.count; ++i) finished(i, run_single_game(jobs[i], out, limits));
+        return;
+    }
+
+    std::vector<std::unique_ptr<Player>> players;
+    std::vector<UC::BatchGame> games(batch.count);
+    for (size_t k = 0; k < batch.count; ++k) {
+        const GameArgs& g = jobs[batch.first + k];
+        players.push_back(make_player(g.playerAndAlgoFactory1ID, /*player_index=*/1, g.map_width, g.map_height, g.max_steps, g.num_shells));
+        players.push_back(make_player(g.playerAndAlgoFactory2ID, /*player_index=*/2, g.map_width, g.map_height, g.max_steps, g.num_shells));
+        UC::BatchGame& game = games[k];
+        game.map = g.map.get();
+        game.map_name = g.map_name;
+        game.max_steps = g.max_steps;
+        game.num_shells = g.num_shells;
+        game.player1 = players[2 * k].get();
+        game.name1 = g.player1Name;
+        game.player2 = players[2 * k + 1].get();
+        game.name2 = g.player2Name;
+        game.player1_tank_algo_factory = make_tank_factory(g.playerAndAlgoFactory1ID);
+        game.player2_tank_algo_factory = make_tank_factory(g.playerAndAlgoFactory2ID);
+    }
+
+    // each game is reported as soon as it ends, not when the whole batch does
+    auto gameStart = std::chrono::steady_clock::now();
+    batchGm->runBatch(first.map_width, first.map_height, games, [&](size_t k, GameResult result) {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - gameStart).count();
+        gameStart = now;
+        const GameArgs& g = jobs[batch.first + k];
+        std::string gameFinalState = satelliteViewToString(*result.gameState.get(), g.map_width, g.map_height);
+        RanGame ran{ g.GameManagerName, g.map_name, g.playerAndAlgoFactory1ID, g.playerAndAlgoFactory2ID, std::move(result), gameFinalState, timeoutOf(gm.get(), k),
+                     playSecondsOf(gm.get(), k, seconds) };
+        reportTimeout(ran);
+        finished(batch.first + k, std::move(ran));
+    });
+}
+
+
+std::vector<GameBatch> make_batches(const std::vector<GameArgs>& jobs, size_t max_batch, const std::vector<double>& costs, double max_cost) {
+    // consecutive jobs with the same game manager and map size share a batch, so results keep job order
+    std::vector<GameBatch> batches;
+    double lastCost = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const double cost = costs.empty() ? 0 : costs[i];
+        if (!batches.empty()) {
+            GameBatch& last = batches.back();
+            const GameArgs& head = jobs[last.first];
+            const bool fits = max_cost <= 0 || lastCost + cost <= max_cost;
+            if (last.count < max_batch && fits && head.GameManagerID == jobs[i].GameManagerID &&
+                head.map_width == jobs[i].map_width && head.map_height == jobs[i].map_height) {
+                ++last.count;
+                lastCost += cost;
+                continue;
+            }
+        }
+        batches.push_back(GameBatch{i, 1});
+        lastCost = cost;
+    }
+    return batches;
+}
+
+
+double estimate_game_cost(const GameArgs& g) {
+    // every tank plans over the board each step, on top of the per-cell work of the step itself
+    const double cells = static_cast<double>(g.map_width) * static_cast<double>(g.map_height);
+    return static_cast<double>(g.max_steps) * cells * static_cast<double>(1 + g.map_tanks);
+}
+
+
+void runThreads(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_threads, const OutputOptions& out, const RunLimits& limits) {
+    // no batch takes more than a fraction of a thread's share, in games or in estimated cost:
+    // batching must never leave the work-stealing queues without work to hand around
+    const size_t slices = static_cast<size_t>(num_threads) * BATCHES_PER_THREAD;
+    std::vector<double> jobCosts(jobs.size());
+    double total = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) total += jobCosts[i] = estimate_game_cost(jobs[i]);
+    const std::vector<GameBatch> batches = make_batches(jobs, std::max<size_t>(1, std::min(MAX_BATCH_GAMES, jobs.size() / slices)),
+                                                        jobCosts, total / slices);
+    std::vector<double> costs(batches.size(), 0);
+    for (size_t b = 0; b < batches.size(); ++b) {
+        for (size_t i = batches[b].first; i < batches[b].first + batches[b].count; ++i) costs[b] += jobCosts[i];
+    }
+    WorkStealingQueues queues(costs, num_threads);
+    std::vector<ThreadUsage> usage(num_threads);
+
+    std::atomic<size_t> skipped{0};
+    auto worker = [&](size_t t) {
+        GameManagerCache engines;
+        while (std::optional<WorkStealingQueues::Task> task = queues.next(t)) {
+            const GameBatch& batch = batches[task->job];
+            if (limits.cancel && limits.cancel->isCancelled()) { skipped += batch.count; continue; }
+            const auto start = std::chrono::steady_clock::now();
+            run_game_batch(jobs, batch, out, limits, engines,
+                           [&](size_t job, RanGame ran) { mode->applyCompetitionScore(jobs[job], std::move(ran)); });
+            usage[t].busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++usage[t].jobs;
+            usage[t].stolen += task->stolen;
         }
     };
 
+    const auto start = std::chrono::steady_clock::now();
     std::vector<std::thread> threads;
     for (int t = 0; t < num_threads; ++t) {
-        threads.emplace_back(worker);
+        threads.emplace_back(worker, static_cast<size_t>(t));
     }
     for (auto& th : threads) {
         th.join();
     }
+    reportThreadUsage(std::cerr, usage, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), "batch(es)");
+    if (out.verbose) reportVerboseOutput(std::cerr, verboseOutputStats());
+    if (skipped) std::cerr << "Interrupted: " << skipped << " game(s) not played.\n";
 }
 
 
-void runAllGames(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, bool verbose) {
-    for(const auto& g: jobs) {
-        RanGame rg = run_single_game(g, verbose);
-        mode->applyCompetitionScore(g, std::move(rg.result), rg.gameFinalState);
+void runAllGames(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, const OutputOptions& out, const RunLimits& limits) {
+    size_t skipped = 0;
+    GameManagerCache engines;
+    for (const GameBatch& batch : make_batches(jobs, MAX_BATCH_GAMES)) {
+        if (limits.cancel && limits.cancel->isCancelled()) { skipped += batch.count; continue; }
+        run_game_batch(jobs, batch, out, limits, engines,
+                       [&](size_t job, RanGame ran) { mode->applyCompetitionScore(jobs[job], std::move(ran)); });
     }
+    if (out.verbose) reportVerboseOutput(std::cerr, verboseOutputStats());
+    if (skipped) std::cerr << "Interrupted: " << skipped << " game(s) not played.\n";
 }
 
 
@@ -114,10 +323,15 @@ std::unique_ptr<AbstractMode> createMode(Cli cli, std::vector<std::string> &maps
         for (auto* r: reqs) if (!cli.kv.count(r)) { usage(std::string("Missing ") + r); return nullptr; }
         if (!dir_exists(cli.kv["game_maps_folder"])) { usage("game_maps_folder missing/not dir: " + cli.kv["game_maps_folder"]); return nullptr; }
         if (!dir_exists(cli.kv["algorithms_folder"])) { usage("algorithms_folder missing/not dir: " + cli.kv["algorithms_folder"]); return nullptr; }
-        maps = list_files(cli.kv["game_maps_folder"]);
+        maps = preferBinaryMaps(list_files(cli.kv["game_maps_folder"]));
         if (maps.empty()) { usage("game_maps_folder has no files."); return nullptr; }
-        mode = std::make_unique<CompetitionMode>();
+        auto competition = std::make_unique<CompetitionMode>();
+        const std::string journal = cli.kv.count("journal") ? cli.kv["journal"]
+            : (fs::path(cli.kv["algorithms_folder"]) / ("competition_" + competition->unique_time_str() + ".journal")).string();
+        competition->setJournalPath(journal);
+        mode = std::move(competition);
     }
+    if (cli.kv.count("map_cache")) mode->mapRepository().setCacheDirectory(cli.kv["map_cache"]);
     return mode;
 }
 
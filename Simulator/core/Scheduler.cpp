@@ -0,0 +1,69 @@
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+
+WorkStealingQueues::WorkStealingQueues(const std::vector<double>& costs, size_t threads)
+    : costs(costs), lanes(std::max<size_t>(1, threads)) {
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    // ties keep job order, so equal games still start in the order they were listed
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return costs[a] > costs[b]; });
+
+    for (size_t job : order) {
+        Lane* lightest = &lanes[0];
+        for (Lane& lane : lanes) {
+            if (lane.queuedCost < lightest->queuedCost) lightest = &lane;
+        }
+        lightest->jobs.push_back(job);
+        lightest->queuedCost += costs[job];
+    }
+}
+
+std::optional<WorkStealingQueues::Task> WorkStealingQueues::next(size_t thread) {
+    {
+        Lane& own = lanes[thread];
+        std::lock_guard<std::mutex> lk(own.mtx);
+        if (!own.jobs.empty()) {
+            size_t job = own.jobs.front();
+            own.jobs.pop_front();
+            own.queuedCost -= costs[job];
+            return Task{job, false};
+        }
+    }
+
+    // deques only shrink, so retrying until every one is seen empty terminates
+    while (true) {
+        Lane* victim = nullptr;
+        double most = 0;
+        for (Lane& lane : lanes) {
+            std::lock_guard<std::mutex> lk(lane.mtx);
+            if (!lane.jobs.empty() && (!victim || lane.queuedCost > most)) {
+                victim = &lane;
+                most = lane.queuedCost;
+            }
+        }
+        if (!victim) return std::nullopt;
+
+        std::lock_guard<std::mutex> lk(victim->mtx);
+        if (victim->jobs.empty()) continue; // drained while we looked
+        size_t job = victim->jobs.back();
+        victim->jobs.pop_back();
+        victim->queuedCost -= costs[job];
+        return Task{job, true};
+    }
+}
+
+void reportThreadUsage(std::ostream& os, const std::vector<ThreadUsage>& usage, double wallSeconds, const char* unit) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << "Thread utilization over " << std::fixed << std::setprecision(2) << wallSeconds << "s:\n";
+    for (size_t t = 0; t < usage.size(); ++t) {
+        const double share = wallSeconds > 0 ? 100.0 * usage[t].busySeconds / wallSeconds : 0;
+        os << "  thread " << t << ": " << std::setprecision(1) << share << "% busy, "
+           << usage[t].jobs << " " << unit << ", " << usage[t].stolen << " stolen\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
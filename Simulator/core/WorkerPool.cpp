@@ -0,0 +1,363 @@
+#include "WorkerPool.h"
+
+#ifndef _WIN32
+  #include <csignal>
+  #include <cstring>
+  #include <ctime>
+  #include <map>
+  #include <mutex>
+  #include <new>
+  #include <poll.h>
+  #include <pthread.h>
+  #include <sys/mman.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+void runIsolated(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_workers, const OutputOptions& out, const RunLimits& limits) {
+    std::cerr << "Note: -isolated is not supported on Windows, games run in-process.\n";
+    if (num_workers > 1) runThreads(mode, std::move(jobs), num_workers, out, limits);
+    else runAllGames(mode, std::move(jobs), out, limits);
+}
+
+#else
+
+namespace {
+    // what a worker sends back for one game; the final board follows the channel
+    struct CompactResult {
+        std::int32_t winner;
+        std::int32_t reason;
+        std::int32_t timeout;
+        std::int32_t failed;        // the game threw, the board area holds the message
+        std::uint64_t rounds;
+        std::uint64_t remaining[2];
+        std::uint64_t boardSize;
+        double seconds;
+    };
+
+    // One per worker, in memory shared with it. The worker holds the mutex only to change
+    // `state`, never while a game runs, so a crash inside a plugin cannot leave it locked.
+    struct Channel {
+        enum State : std::int32_t { Idle, JobPosted, Running, ResultReady, Exit };
+
+        pthread_mutex_t mtx;
+        pthread_cond_t changed;
+        State state;
+        std::int64_t job;
+        CompactResult result;
+        UC::VerboseOutputStats verbose; // the worker's totals, written when it exits
+    };
+
+    // How the current worker process of a channel ended, written by the fork server that reaped
+    // it. Kept apart from the channels, which are reset while the server may still write here.
+    struct WorkerSlot {
+        std::atomic<std::int32_t> exited;
+        std::int32_t status;
+    };
+
+    class SharedChannels {
+    public:
+        SharedChannels(size_t count, size_t boardCapacity)
+            : capacity(boardCapacity),
+              stride((sizeof(Channel) + boardCapacity + 63) / 64 * 64),
+              slotBytes((sizeof(WorkerSlot) * count + 63) / 64 * 64),
+              bytes(slotBytes + stride * count) {
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::runtime_error(std::string("mmap failed: ") + std::strerror(errno));
+            base = static_cast<char*>(p);
+            for (size_t w = 0; w < count; ++w) {
+                new (base + w * sizeof(WorkerSlot)) WorkerSlot{};
+                reset(w);
+            }
+        }
+        ~SharedChannels() { munmap(base, bytes); }
+        SharedChannels(const SharedChannels&) = delete;
+        SharedChannels& operator=(const SharedChannels&) = delete;
+
+        WorkerSlot& slot(size_t w) { return *reinterpret_cast<WorkerSlot*>(base + w * sizeof(WorkerSlot)); }
+        Channel& channel(size_t w) { return *reinterpret_cast<Channel*>(base + slotBytes + w * stride); }
+        char* board(size_t w) { return base + slotBytes + w * stride + sizeof(Channel); }
+        size_t boardCapacity() const { return capacity; }
+
+        // (re)initializes channel w; only while no live process uses it
+        void reset(size_t w) {
+            Channel& ch = *new (base + slotBytes + w * stride) Channel{};
+            pthread_mutexattr_t ma;
+            pthread_mutexattr_init(&ma);
+            pthread_mutexattr_setpshared(&ma, PTHREAD_PROCESS_SHARED);
+            pthread_mutex_init(&ch.mtx, &ma);
+            pthread_mutexattr_destroy(&ma);
+            pthread_condattr_t ca;
+            pthread_condattr_init(&ca);
+            pthread_condattr_setpshared(&ca, PTHREAD_PROCESS_SHARED);
+            pthread_cond_init(&ch.changed, &ca);
+            pthread_condattr_destroy(&ca);
+            ch.state = Channel::Idle;
+        }
+
+    private:
+        char* base = nullptr;
+        size_t capacity;
+        size_t stride;
+        size_t slotBytes;
+        size_t bytes;
+    };
+
+    void setState(Channel& ch, Channel::State state) {
+        pthread_mutex_lock(&ch.mtx);
+        ch.state = state;
+        pthread_cond_broadcast(&ch.changed);
+        pthread_mutex_unlock(&ch.mtx);
+    }
+
+    [[noreturn]] void workerMain(SharedChannels& channels, size_t w, const std::vector<GameArgs>& jobs,
+                                 const OutputOptions& out, const RunLimits& limits) {
+        Channel& ch = channels.channel(w);
+        char* board = channels.board(w);
+        while (true) {
+            pthread_mutex_lock(&ch.mtx);
+            while (ch.state != Channel::JobPosted && ch.state != Channel::Exit) pthread_cond_wait(&ch.changed, &ch.mtx);
+            if (ch.state == Channel::Exit) {
+                if (out.verbose) ch.verbose = verboseOutputStats();
+                pthread_mutex_unlock(&ch.mtx);
+                _exit(0); // the parent owns every file and plugin, nothing to tear down here
+            }
+            ch.state = Channel::Running;
+            const size_t job = static_cast<size_t>(ch.job);
+            pthread_mutex_unlock(&ch.mtx);
+
+            CompactResult& r = ch.result;
+            std::string text;
+            try {
+                RanGame ran = run_single_game(jobs[job], out, limits);
+                r = CompactResult{ ran.result.winner, static_cast<std::int32_t>(ran.result.reason),
+                                   static_cast<std::int32_t>(ran.timeout), 0, ran.result.rounds, {}, 0, ran.seconds };
+                for (size_t p = 0; p < 2 && p < ran.result.remaining_tanks.size(); ++p) r.remaining[p] = ran.result.remaining_tanks[p];
+                text = std::move(ran.gameFinalState);
+            }
+            catch (const std::exception& e) { r = CompactResult{}; r.failed = 1; text = std::string("exception: ") + e.what(); }
+            catch (...) { r = CompactResult{}; r.failed = 1; text = "unknown exception"; }
+            r.boardSize = std::min(text.size(), channels.boardCapacity());
+            std::memcpy(board, text.data(), r.boardSize);
+            setState(ch, Channel::ResultReady);
+        }
+    }
+
+    // Forks the workers for the supervisor threads. The server itself is forked before any of
+    // those threads exist and stays single-threaded, so a worker never starts life in a copy of a
+    // process whose other threads held a lock (malloc's, the stream's, a plugin's) at fork time.
+    // It reaps the workers too and posts how each one ended in its WorkerSlot.
+    class ForkServer {
+    public:
+        ForkServer(SharedChannels& channels, const std::vector<GameArgs>& jobs, const OutputOptions& out, const RunLimits& limits) {
+            int req[2], rep[2];
+            if (pipe(req) != 0 || pipe(rep) != 0) throw std::runtime_error(std::string("pipe failed: ") + std::strerror(errno));
+            std::cout.flush(); // nothing buffered may be written twice
+            server = fork();
+            if (server < 0) throw std::runtime_error(std::string("fork failed: ") + std::strerror(errno));
+            if (server == 0) {
+                close(req[1]);
+                close(rep[0]);
+                serve(req[0], rep[1], channels, jobs, out, limits);
+            }
+            close(req[0]);
+            close(rep[1]);
+            requests = req[1];
+            replies = rep[0];
+        }
+        // every worker must have exited; the server sees the pipe close and ends
+        ~ForkServer() {
+            close(requests);
+            close(replies);
+            waitpid(server, nullptr, 0);
+        }
+        ForkServer(const ForkServer&) = delete;
+        ForkServer& operator=(const ForkServer&) = delete;
+
+        // starts a worker on channel w, whose previous worker (if any) has been reaped
+        pid_t spawn(size_t w) {
+            std::lock_guard<std::mutex> lock(mtx);
+            const std::uint32_t request = static_cast<std::uint32_t>(w);
+            std::int32_t reply = -EPIPE;
+            if (write(requests, &request, sizeof(request)) != sizeof(request) || read(replies, &reply, sizeof(reply)) != sizeof(reply))
+                reply = -EPIPE;
+            if (reply < 0) throw std::runtime_error(std::string("fork failed: ") + std::strerror(-reply));
+            return reply;
+        }
+
+    private:
+        pid_t server = -1;
+        int requests = -1;
+        int replies = -1;
+        std::mutex mtx;
+
+        [[noreturn]] static void serve(int requests, int replies, SharedChannels& channels, const std::vector<GameArgs>& jobs,
+                                       const OutputOptions& out, const RunLimits& limits) {
+            std::map<pid_t, size_t> live; // worker pid -> its channel
+            auto reap = [&](int flags) {
+                int status = 0;
+                for (pid_t pid; (pid = waitpid(-1, &status, flags)) > 0;) {
+                    auto it = live.find(pid);
+                    if (it == live.end()) continue;
+                    WorkerSlot& slot = channels.slot(it->second);
+                    slot.status = status;
+                    slot.exited.store(1, std::memory_order_release);
+                    live.erase(it);
+                }
+            };
+            while (true) {
+                pollfd request{ requests, POLLIN, 0 };
+                const int ready = poll(&request, 1, 10);
+                reap(WNOHANG);
+                if (ready <= 0) continue; // a timeout, or interrupted by SIGINT
+
+                std::uint32_t w = 0;
+                const ssize_t n = read(requests, &w, sizeof(w));
+                if (n < 0 && errno == EINTR) continue;
+                if (n != sizeof(w)) {
+                    // the Simulator is done, or gone: no worker outlives it
+                    for (const auto& [pid, worker] : live) kill(pid, SIGKILL);
+                    reap(0);
+                    _exit(0);
+                }
+                channels.slot(w).exited.store(0, std::memory_order_release);
+                const pid_t pid = fork();
+                if (pid == 0) {
+                    close(requests);
+                    close(replies);
+                    workerMain(channels, w, jobs, out, limits);
+                }
+                if (pid > 0) live[pid] = w;
+                const std::int32_t reply = pid > 0 ? pid : -errno;
+                if (write(replies, &reply, sizeof(reply)) != sizeof(reply)) _exit(1);
+            }
+        }
+    };
+
+    // blocks until the fork server has reaped the worker of a slot
+    void awaitExit(const WorkerSlot& slot) {
+        while (!slot.exited.load(std::memory_order_acquire)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::string describeExit(int status) {
+        if (WIFSIGNALED(status)) {
+            const char* name = strsignal(WTERMSIG(status));
+            return "worker killed by signal " + std::to_string(WTERMSIG(status)) + (name ? std::string(" (") + name + ")" : "");
+        }
+        if (WIFEXITED(status)) return "worker exited with status " + std::to_string(WEXITSTATUS(status));
+        return "worker lost";
+    }
+}
+
+
+void runIsolated(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_workers, const OutputOptions& out, const RunLimits& limits) {
+    // the final board comes back as text: one row per map row plus the newlines
+    size_t boardCapacity = 256; // room for an exception message
+    std::vector<double> costs(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        boardCapacity = std::max(boardCapacity, (jobs[i].map_width + 1) * jobs[i].map_height);
+        costs[i] = estimate_game_cost(jobs[i]);
+    }
+    // one game per job, so a crash costs exactly one game
+    WorkStealingQueues queues(costs, num_workers);
+    SharedChannels channels(num_workers, boardCapacity);
+    // forked here, before any supervisor thread exists; every worker, first or replacement, comes from it
+    ForkServer server(channels, jobs, out, limits);
+    std::vector<pid_t> pids(num_workers, -1);
+    for (int w = 0; w < num_workers; ++w) pids[w] = server.spawn(w);
+
+    // a game still running this long after game_time_ms is stuck in a call that never returns
+    const bool hardLimit = limits.budget.game.count() > 0;
+    const auto hardBudget = limits.budget.game * 2 + std::chrono::seconds(1);
+
+    std::vector<ThreadUsage> usage(num_workers);
+    std::atomic<size_t> skipped{0};
+    auto supervisor = [&](size_t w) {
+        while (std::optional<WorkStealingQueues::Task> task = queues.next(w)) {
+            const size_t job = task->job;
+            if (limits.cancel && limits.cancel->isCancelled()) { ++skipped; continue; }
+            const auto start = std::chrono::steady_clock::now();
+            Channel& ch = channels.channel(w);
+            pthread_mutex_lock(&ch.mtx);
+            ch.job = static_cast<std::int64_t>(job);
+            ch.state = Channel::JobPosted;
+            pthread_cond_broadcast(&ch.changed);
+
+            // wake up periodically to notice a dead worker, an overrun or a cancellation
+            bool done = false, interruptSent = false;
+            std::string failure;
+            while (!done) {
+                if (ch.state == Channel::ResultReady) { done = true; break; }
+                timespec until{};
+                clock_gettime(CLOCK_REALTIME, &until);
+                until.tv_nsec += 100'000'000;
+                if (until.tv_nsec >= 1'000'000'000) { until.tv_sec += 1; until.tv_nsec -= 1'000'000'000; }
+                pthread_cond_timedwait(&ch.changed, &ch.mtx, &until);
+                if (ch.state == Channel::ResultReady) { done = true; break; }
+
+                pthread_mutex_unlock(&ch.mtx);
+                WorkerSlot& slot = channels.slot(w);
+                if (slot.exited.load(std::memory_order_acquire)) {
+                    failure = describeExit(slot.status);
+                }
+                else if (hardLimit && std::chrono::steady_clock::now() - start > hardBudget) {
+                    kill(pids[w], SIGKILL);
+                    awaitExit(slot);
+                    failure = "worker killed after exceeding game_time_ms";
+                }
+                else if (!interruptSent && limits.cancel && limits.cancel->isCancelled()) {
+                    // the worker may not share our terminal; let its game end at the next round
+                    kill(pids[w], SIGINT);
+                    interruptSent = true;
+                }
+                if (!failure.empty()) break;
+                pthread_mutex_lock(&ch.mtx);
+            }
+
+            if (done) {
+                ch.state = Channel::Idle;
+                pthread_mutex_unlock(&ch.mtx);
+                const CompactResult& r = ch.result;
+                std::string text(channels.board(w), r.boardSize);
+                if (r.failed) mode->recordFailedGame(jobs[job], text);
+                else {
+                    const GameArgs& g = jobs[job];
+                    RanGame ran{ g.GameManagerName, g.map_name, g.playerAndAlgoFactory1ID, g.playerAndAlgoFactory2ID, GameResult{},
+                                 std::move(text), static_cast<UC::Timeout>(r.timeout), r.seconds };
+                    ran.result.winner = r.winner;
+                    ran.result.reason = static_cast<GameResult::Reason>(r.reason);
+                    ran.result.remaining_tanks = { r.remaining[0], r.remaining[1] };
+                    ran.result.rounds = r.rounds;
+                    mode->applyCompetitionScore(g, std::move(ran));
+                }
+            }
+            else {
+                mode->recordFailedGame(jobs[job], failure);
+                channels.reset(w);
+                pids[w] = server.spawn(w);
+            }
+            usage[w].busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++usage[w].jobs;
+            usage[w].stolen += task->stolen;
+        }
+        setState(channels.channel(w), Channel::Exit);
+        awaitExit(channels.slot(w));
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int w = 0; w < num_workers; ++w) threads.emplace_back(supervisor, static_cast<size_t>(w));
+    for (auto& th : threads) th.join();
+    reportThreadUsage(std::cerr, usage, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), "game(s)");
+    if (out.verbose) {
+        // the games ran in the workers, their plugins wrote the files
+        UC::VerboseOutputStats total;
+        for (int w = 0; w < num_workers; ++w) total += channels.channel(w).verbose;
+        reportVerboseOutput(std::cerr, total);
+    }
+    if (skipped) std::cerr << "Interrupted: " << skipped << " game(s) not played.\n";
+}
+
+#endif
@@ -6,21 +6,26 @@
 #include "GameManagerRegistrar.h"
 #include "AlgorithmRegistrar.h"
 #include "InitialSatellite.h"
+#include "MapRepository.h"
 #include "PluginLoader.h"
+#include "UserCommon/GameBudget.h"
 #include <set>
 #include <utility>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <memory>
-#include <regex>
 #include <atomic>
+#include <mutex>
+#include <ostream>
 
+namespace UC = UserCommon_212788293_212497127;
 
 struct GameArgs
 {
     size_t map_width, map_height, max_steps, num_shells;
-    std::unique_ptr<SatelliteView> map;
+    std::shared_ptr<const SatelliteView> map; // shared by every game on the map
+    size_t map_tanks;                         // GameMap::tanks
     std::string map_name, GameManagerName, player1Name, player2Name;
     size_t playerAndAlgoFactory1ID, playerAndAlgoFactory2ID, GameManagerID;
 };
@@ -31,19 +36,48 @@ struct ParsedMap
     size_t map_height{};
     size_t max_steps{};
     size_t num_shells{};
-    std::set<std::pair<size_t, size_t>> player1tanks;
-    std::set<std::pair<size_t, size_t>> player2tanks;
-    std::set<std::pair<size_t, size_t>> mines;
-    std::set<std::pair<size_t, size_t>> walls;
+    std::vector<char> cells; // row-major map symbols: ' ', '#', '@', '1', '2'
 };
 
+// a finished game as reported to the mode
+struct RanGame
+{
+    std::string gm_name;
+    std::string map_name;
+    size_t algo1_id, algo2_id;
+    GameResult result;
+    std::string gameFinalState;
+    UC::Timeout timeout = UC::Timeout::None; // why the game was cut short; result.reason is MAX_STEPS then
+    double seconds = 0;                      // time spent playing it, its own rounds only when batched
+};
+
+// how a game ended as written in the results: the GameResult reason, or the timeout that cut it short
+const char *reasonName(GameResult::Reason reason, UC::Timeout timeout);
+
+// parses the bytes of a map file in one pass; `filename` only names it in errors
+ParsedMap parseBattlefield(const char *data, size_t size, const std::string &filename);
+
 class AbstractMode
 {
 public:
     virtual ~AbstractMode() = default;
     virtual std::vector<GameArgs> getAllGames(std::vector<std::string> game_maps) = 0;
     virtual int openSOFiles(Cli cli, std::vector<LoadedLib> algoLibs, std::vector<LoadedLib> gmLibs) = 0;
-    virtual void applyCompetitionScore(const GameArgs &g, GameResult res, std::string finalGameState) = 0;
-    ParsedMap parseBattlefieldFile(const std::string &filename);
+    virtual void applyCompetitionScore(const GameArgs &g, RanGame ran) = 0;
+    // games getAllGames left out because an earlier, interrupted run already played them
+    virtual size_t resumedGames() const { return 0; }
     std::string unique_time_str();
+    MapRepository &mapRepository() { return maps; }
+
+    // games that produced no result because their worker process died (-isolated); they
+    // score nothing and are listed at the end of the results file
+    void recordFailedGame(const GameArgs &g, const std::string &why);
+    void writeFailedGames(std::ostream &out);
+
+protected:
+    MapRepository maps;
+
+private:
+    std::mutex failed_mtx;
+    std::vector<std::string> failedGames;
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "MapRepository.h"
+#include "MappedFile.h"
+#include "UserCommon/BinaryMap.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A binary map (UserCommon/BinaryMap.h) read in place from the mapped file: cells are
+// decoded on access, nothing is parsed or copied when the map is loaded.
+class BinaryMapView : public SatelliteView, public UserCommon_212788293_212497127::BulkSatelliteView {
+    private:
+        std::unique_ptr<MappedFile> file;
+        const std::uint8_t *grid;
+        size_t width;
+        size_t height;
+    public:
+        BinaryMapView(std::unique_ptr<MappedFile> file, size_t width, size_t height);
+
+        char getObjectAt(size_t x, size_t y) const override;
+        void copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const override;
+};
+
+bool isBinaryMapPath(const std::string &path);
+
+// drops every file that has a binary map of the same name beside it (m.txt when m.bin is
+// listed too), so a folder converted in place still holds each map once
+std::vector<std::string> preferBinaryMaps(const std::vector<std::string> &files);
+
+// maps and checks a binary map file; throws std::runtime_error naming `path` when the file
+// is missing, truncated, of another version or fails its checksum
+std::shared_ptr<const GameMap> loadBinaryMap(const std::string &path);
+
+// writes `map` in the binary format through a temporary file renamed over `path`, so a file
+// already mapped by a reader is never changed under it; false with `err` set on failure
+bool writeBinaryMap(const std::string &path, const GameMap &map, std::string &err);
@@ -8,10 +8,12 @@ struct ComparativeKey {
     GameResult::Reason reason;
     size_t rounds;
     std::string finalBoard;
+    UC::Timeout timeout;
 
     bool operator==(const ComparativeKey& o) const {
         return winner == o.winner &&
                reason == o.reason &&
+               timeout == o.timeout &&
                rounds == o.rounds &&
                finalBoard == o.finalBoard;
     }
@@ -20,7 +22,7 @@ struct ComparativeKey {
 struct ComparativeKeyHash {
     size_t operator()(const ComparativeKey& k) const noexcept {
         size_t h1 = std::hash<int>{}(k.winner);
-        size_t h2 = std::hash<int>{}(static_cast<int>(k.reason));
+        size_t h2 = std::hash<int>{}(static_cast<int>(k.reason) * 8 + static_cast<int>(k.timeout));
         size_t h3 = std::hash<size_t>{}(k.rounds);
         size_t h4 = std::hash<std::string>{}(k.finalBoard);
         return (((h1 ^ (h2 << 1)) >> 1) ^ (h3 << 1)) ^ h4;
@@ -40,7 +42,7 @@ class ComparativeMode: public AbstractMode {
     int openSOFiles(Cli cli, std::vector<LoadedLib> algoLibs, std::vector<LoadedLib> gmLibs) override;
     int register2Algorithms(Cli cli, std::vector<LoadedLib> algoLibs);
     int registerGameManagers(Cli cli, std::vector<LoadedLib> gmLibs);
-    void applyCompetitionScore(const GameArgs& g, GameResult res, std::string finalGameState) override ;
+    void applyCompetitionScore(const GameArgs& g, RanGame ran) override ;
     void writeComparativeResults(const std::string& game_managers_folder, const std::string& game_map_filename, const std::string& algorithm1_so, const std::string& algorithm2_so);
 
      
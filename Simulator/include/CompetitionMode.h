@@ -1,12 +1,20 @@
 #pragma once
 
 #include "AbstractMode.h"
+#include "ResultJournal.h"
 
 
 
 class CompetitionMode: public AbstractMode {
 
     std::map<std::string, std::atomic<size_t>> algoNamesAndScores;
+    // every finished game, in the order they finished; the scores are a fold over it
+    ResultJournal journal;
+    std::string journalPath;
+    size_t resumed = 0;
+
+    void resumeFromJournal(std::vector<GameArgs>& games);
+    void applyEntry(const JournalEntry& e);
 
     public:
     ~CompetitionMode() override = default;
@@ -14,7 +22,10 @@ class CompetitionMode: public AbstractMode {
     int openSOFiles(Cli cli, std::vector<LoadedLib> algoLibs, std::vector<LoadedLib> gmLibs) override;
     int registerAlgorithms(Cli cli, std::vector<LoadedLib> algoLibs);
     int registerGameManager(Cli cli, std::vector<LoadedLib> gmLibs);
-    void applyCompetitionScore(const GameArgs& g, GameResult res, std::string finalGameState) override ;
+    void applyCompetitionScore(const GameArgs& g, RanGame ran) override ;
+    // the journal to append to; games it already holds are not played again
+    void setJournalPath(const std::string& path) { journalPath = path; }
+    size_t resumedGames() const override { return resumed; }
     void add_relaxed(std::atomic<size_t>& x, size_t d);
     std::vector<std::pair<std::string, size_t>> build_sorted_score_table();
     void writeCompetitionResults(const std::string& algorithms_folder, const std::string& game_maps_folder, const std::string& game_manager_so);
@@ -1,20 +1,21 @@
 #pragma once
 
 #include "common/SatelliteView.h"
-#include <set>
+#include "UserCommon/BulkSatelliteView.h"
+#include <vector>
 
-class InitialSatellite : public SatelliteView {
+// The map a game starts from: one symbol per cell, row-major. Immutable once built, so a
+// single instance is shared by every game played on the map.
+class InitialSatellite : public SatelliteView, public UserCommon_212788293_212497127::BulkSatelliteView {
     private:
-        std::set<std::pair<size_t,size_t>> player1Tanks;
-        std::set<std::pair<size_t,size_t>> player2Tanks;
-        std::set<std::pair<size_t,size_t>> walls;
-        std::set<std::pair<size_t,size_t>> mines;
+        size_t width;
+        size_t height;
+        std::vector<char> cells;
     public:
-        InitialSatellite(std::set<std::pair<size_t,size_t>> player1Tanks
-        ,std::set<std::pair<size_t,size_t>> player2Tanks
-        ,std::set<std::pair<size_t,size_t>> walls
-        ,std::set<std::pair<size_t,size_t>> mines) : player1Tanks(player1Tanks), 
-        player2Tanks(player2Tanks), walls(walls), mines(mines) {}
+        InitialSatellite(size_t width, size_t height, std::vector<char> cells)
+            : width(width), height(height), cells(std::move(cells)) {}
 
         char getObjectAt(size_t x, size_t y) const override ;
-        };
\ No newline at end of file
+        void copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const override;
+        UserCommon_212788293_212497127::SatelliteSpan span() const override { return {cells.data(), width, height}; }
+        };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "InitialSatellite.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// A map loaded once; every game on it shares `view`
+struct GameMap
+{
+    size_t map_width{};
+    size_t map_height{};
+    size_t max_steps{};
+    size_t num_shells{};
+    std::shared_ptr<const SatelliteView> view;
+    size_t tanks{}; // '1' and '2' cells, counted once for the jobs' cost estimates
+};
+
+// Loads each map file once per run and hands the same GameMap to every job on it. Text maps
+// are parsed; binary maps (.bin, UserCommon/BinaryMap.h) are mapped and read in place. With
+// a cache directory (map_cache=<dir>) parsed text maps are also kept on disk between runs as
+// binary maps, keyed by a hash of the file contents, so an edited map never reuses a stale
+// entry. Used while the job list is built, not thread-safe.
+class MapRepository
+{
+public:
+    void setCacheDirectory(const std::string &dir) { cacheDir = dir; }
+
+    // throws std::runtime_error for unreadable or invalid maps
+    std::shared_ptr<const GameMap> load(const std::string &path);
+
+private:
+    std::shared_ptr<const GameMap> readCache(const std::string &file) const;
+    void writeCache(const std::string &file, const GameMap &map) const;
+
+    std::string cacheDir;
+    std::unordered_map<std::string, std::shared_ptr<const GameMap>> maps;
+};
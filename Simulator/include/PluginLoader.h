@@ -27,6 +27,9 @@ struct Cli
         Competition
     } mode;
     bool verbose = false;
+    bool replay = false; // record binary replays into replays/
+    bool deltaFrames = false; // with -verbose: write most visualization rounds as delta frames
+    bool isolated = false;    // play the games in pre-forked worker processes
     std::unordered_map<std::string, std::string> kv;
 };
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// one finished game as a journal line
+struct JournalEntry
+{
+    std::string map;          // file name of the map, without its folder
+    std::string gameManager;
+    std::string player1, player2;
+    int winner = 0;           // 0 tie, else the winning player
+    std::string reason;       // reasonName() of the game
+    size_t rounds = 0;
+    double seconds = 0;
+};
+
+// Append-only record of the games a run has finished, one tab separated line per game, written
+// as each game ends. Every line is flushed to the file when appended, so a killed Simulator loses
+// nothing; the file is synced to disk every SYNC_EVERY games or SYNC_INTERVAL, which bounds what
+// a power loss can take. The journal a run leaves behind is read back to resume that run.
+// append() may be called from several threads.
+class ResultJournal
+{
+public:
+    static constexpr size_t SYNC_EVERY = 32;
+    static constexpr std::chrono::seconds SYNC_INTERVAL{2};
+
+    ResultJournal() = default;
+    ~ResultJournal();
+    ResultJournal(const ResultJournal &) = delete;
+    ResultJournal &operator=(const ResultJournal &) = delete;
+
+    // opens `path` for appending, creating it if needed, and fills `existing` with the games
+    // already in it. A torn last line (a write cut short) is cut off. False with `err` set when
+    // the file cannot be opened or was not written by a ResultJournal.
+    bool open(const std::string &path, std::vector<JournalEntry> &existing, std::string &err);
+    bool isOpen() const { return file != nullptr; }
+    const std::string &path() const { return filePath; }
+
+    void append(const JournalEntry &entry);
+    // forces everything appended so far to disk
+    void sync();
+
+private:
+    void syncLocked();
+
+    std::mutex mtx;
+    std::FILE *file = nullptr;
+    std::string filePath;
+    size_t unsynced = 0;
+    std::chrono::steady_clock::time_point lastSync;
+};
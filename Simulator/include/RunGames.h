@@ -6,23 +6,74 @@
 #include "GameManagerRegistrar.h"
 #include "AlgorithmRegistrar.h"
 #include "common/GameResult.h"
+#include "UserCommon/BatchGameManager.h"
+#include "UserCommon/BulkSatelliteView.h"
+#include "UserCommon/GameBudget.h"
+#include "UserCommon/Replay.h"
+#include "UserCommon/VerboseOutput.h"
+#include "UserCommon/VisualizationFormat.h"
+#include "Scheduler.h"
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
 
-struct RanGame {
-    std::string gm_name;
-    std::string map_name;
-    size_t algo1_id, algo2_id;
-    GameResult result;
-    std::string gameFinalState;
+namespace UC = UserCommon_212788293_212497127;
+
+// upper bound on the number of games a game manager plays in one runBatch call
+constexpr size_t MAX_BATCH_GAMES = 32;
+
+// a threaded run cuts each thread's share of the work into at least this many batches, so a
+// thread that runs dry still finds batches to steal and a bad cost estimate evens out
+constexpr size_t BATCHES_PER_THREAD = 8;
+
+// directory the game managers write binary replays into (-replay)
+inline constexpr const char *kReplayDir = "replays";
+
+// what the game managers write besides the results
+struct OutputOptions {
+    bool verbose = false;
+    bool replay = false;      // binary replays into kReplayDir
+    bool deltaFrames = false; // delta frames in the verbose visualization files
 };
 
+// time limits of the run: game_time_ms= / tank_call_ms=, and SIGINT to stop early
+struct RunLimits {
+    UC::GameBudget budget;
+    std::shared_ptr<UC::CancellationToken> cancel;
+};
+
+// jobs[first, first + count) share a game manager and a map size
+struct GameBatch {
+    size_t first;
+    size_t count;
+};
+
+// the game managers one thread plays its batches on, by GameManagerID. A batch-capable game
+// manager is kept for every batch of the thread, so its storage is allocated once per thread;
+// any other one is only asked whether it is batch-capable, and each game gets a fresh one.
+using GameManagerCache = std::map<size_t, std::unique_ptr<AbstractGameManager>>;
+
 TankAlgorithmFactory make_tank_factory(size_t algo_id);
 std::unique_ptr<Player> make_player(size_t algo_id, int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells);
-RanGame run_single_game(const GameArgs& g, bool verbose);
+std::unique_ptr<AbstractGameManager> make_game_manager(const GameArgs& g, const OutputOptions& out, const RunLimits& limits);
+RanGame run_single_game(const GameArgs& g, const OutputOptions& out, const RunLimits& limits);
+// receives each game of a batch as soon as it is over, with its index in the jobs
+using GameFinished = std::function<void(size_t job, RanGame ran)>;
+void run_game_batch(const std::vector<GameArgs>& jobs, const GameBatch& batch, const OutputOptions& out, const RunLimits& limits, GameManagerCache& engines,
+                    const GameFinished& finished);
+double estimate_game_cost(const GameArgs& g);
+// with `costs` (one per job), a batch never grows past `max_cost` and a job costing more plays alone
+std::vector<GameBatch> make_batches(const std::vector<GameArgs>& jobs, size_t max_batch, const std::vector<double>& costs = {}, double max_cost = 0);
 void openSOFilesCompetitionMode(Cli cli, std::vector<LoadedLib>& algoLibs, std::vector<LoadedLib>& gmLibs);
 std::string satelliteViewToString(const SatelliteView& view, size_t width, size_t height);
-void runThreads(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_threads, bool verbose);
-void runAllGames(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, bool verbose);
+// what the game manager plugins loaded in this process have spent on verbose output so far
+UC::VerboseOutputStats verboseOutputStats();
+void reportVerboseOutput(std::ostream& os, const UC::VerboseOutputStats& stats);
+void runThreads(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_threads, const OutputOptions& out, const RunLimits& limits);
+void runAllGames(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, const OutputOptions& out, const RunLimits& limits);
+OutputOptions outputOptions(const Cli& cli);
+bool runLimits(Cli& cli, RunLimits& limits);
 std::unique_ptr<AbstractMode> createMode(Cli cli, std::vector<std::string> &maps);
 void runModeResults(AbstractMode* mode, Cli& cli);
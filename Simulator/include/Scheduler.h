@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+// Work-stealing queues over job indices, one per thread. Jobs are dealt longest first,
+// each to the thread with the least work queued, so the expensive games start early and
+// the loads come out even. A thread takes its own jobs from the front; once its deque is
+// empty it steals from the back of the deque with the most work left.
+class WorkStealingQueues {
+public:
+    struct Task {
+        size_t job;
+        bool stolen;
+    };
+
+    WorkStealingQueues(const std::vector<double>& costs, size_t threads);
+
+    // next job for `thread`, or nothing once every deque is empty
+    std::optional<Task> next(size_t thread);
+
+private:
+    struct Lane {
+        std::mutex mtx;
+        std::deque<size_t> jobs;
+        double queuedCost = 0;
+    };
+
+    std::vector<double> costs;
+    std::vector<Lane> lanes;
+};
+
+// what one worker thread did during a run
+struct ThreadUsage {
+    size_t jobs = 0;
+    size_t stolen = 0;
+    double busySeconds = 0;
+};
+
+// `unit` names what a job was, e.g. "game(s)"
+void reportThreadUsage(std::ostream& os, const std::vector<ThreadUsage>& usage, double wallSeconds, const char* unit);
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "RunGames.h"
+
+// -isolated: games are played by long-lived worker processes, one per thread, forked once the
+// plugins are loaded so every worker inherits them instead of loading them again. The workers
+// come from a single-threaded fork server started before the supervisor threads, never from the
+// multithreaded Simulator. A worker gets a job index through memory shared with the Simulator
+// and answers with a compact result. A worker that dies, or is killed for running far past
+// game_time_ms, is replaced by a fresh fork; only the game it was playing fails, and it is
+// listed in the results file.
+void runIsolated(std::unique_ptr<AbstractMode>& mode, std::vector<GameArgs> jobs, int num_workers, const OutputOptions& out, const RunLimits& limits);
@@ -6,6 +6,7 @@
 #include "include/GameManagerRegistrar.h"
 #include "include/AlgorithmRegistrar.h"
 #include "RunGames.h"
+#include "WorkerPool.h"
 #include <thread>
 
 
@@ -34,12 +35,19 @@ int main(int argc, char** argv) {
     }
 
     std::vector<GameArgs> jobs = mode->getAllGames(maps);
-    if (jobs.empty()) { std::cerr << "No games to run.\n"; return 0; }
+    if (jobs.empty() && mode->resumedGames() == 0) { std::cerr << "No games to run.\n"; return 0; }
     const size_t n = jobs.size();
-    num_threads = std::min<size_t>(num_threads, n);
+    num_threads = std::max<size_t>(1, std::min<size_t>(num_threads, n));
     
-    if(num_threads > 1)runThreads(mode, std::move(jobs), num_threads, cli.verbose);
-    else runAllGames(mode, std::move(jobs), cli.verbose); 
+    const OutputOptions out = outputOptions(cli);
+    RunLimits limits;
+    if (!runLimits(cli, limits)) return 1;
+    // a resumed run may have nothing left to play, its results come from the journal alone
+    if (!jobs.empty()) {
+        if (cli.isolated) runIsolated(mode, std::move(jobs), num_threads, out, limits);
+        else if(num_threads > 1)runThreads(mode, std::move(jobs), num_threads, out, limits);
+        else runAllGames(mode, std::move(jobs), out, limits); 
+    }
 
     runModeResults(mode.get(), cli);
     
@@ -0,0 +1,56 @@
+// Converts text maps to the binary map format (UserCommon/BinaryMap.h), which the Simulator
+// loads without parsing:
+//   ./map_convert <map.txt | maps_folder>... [out=<dir>]
+// Each map is written as <stem>.bin into out=<dir>, or next to its source.
+
+#include "AbstractMode.h"
+#include "BinaryMapView.h"
+#include "MappedFile.h"
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    std::string outDir;
+    for (int i = 1; i < argc; ++i) {
+        std::string s(argv[i]);
+        if (s.rfind("out=", 0) == 0) outDir = s.substr(4);
+        else inputs.push_back(s);
+    }
+    if (inputs.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <map.txt | maps_folder>... [out=<dir>]\n";
+        return 1;
+    }
+
+    std::vector<std::string> maps;
+    for (const std::string& in : inputs) {
+        if (dir_exists(in)) {
+            for (const std::string& f : list_files(in)) if (!isBinaryMapPath(f)) maps.push_back(f);
+        }
+        else maps.push_back(in);
+    }
+    if (!outDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(outDir, ec);
+    }
+
+    int failures = 0;
+    for (const std::string& path : maps) {
+        try {
+            MappedFile file;
+            if (!file.open(path)) throw std::runtime_error("Cannot open map file: " + path);
+            ParsedMap parsed = parseBattlefield(file.data(), file.size(), path);
+            GameMap map{ parsed.map_width, parsed.map_height, parsed.max_steps, parsed.num_shells,
+                         std::make_shared<const InitialSatellite>(parsed.map_width, parsed.map_height, std::move(parsed.cells)) };
+
+            fs::path target = fs::path(path).replace_extension(UserCommon_212788293_212497127::BinaryMap::EXTENSION);
+            if (!outDir.empty()) target = fs::path(outDir) / target.filename();
+            std::string err;
+            if (!writeBinaryMap(target.string(), map, err)) throw std::runtime_error(err);
+            std::cout << path << " -> " << target.string() << "\n";
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "common/GameResult.h"
+#include "common/Player.h"
+#include "common/SatelliteView.h"
+#include "common/TankAlgorithm.h"
+
+namespace UserCommon_212788293_212497127
+{
+    // One game of a batch; the map, players and factories are owned by the caller
+    struct BatchGame
+    {
+        const SatelliteView *map{};
+        std::string map_name;
+        size_t max_steps{};
+        size_t num_shells{};
+        Player *player1{};
+        std::string name1;
+        Player *player2{};
+        std::string name2;
+        TankAlgorithmFactory player1_tank_algo_factory;
+        TankAlgorithmFactory player2_tank_algo_factory;
+    };
+
+    // ========================= CLASS: BatchGameManager =========================
+    // Optional extension of AbstractGameManager (common/ is fixed): a game manager that plays
+    // several games on maps of the same size back to back, reusing its storage from one game to
+    // the next, and that may be kept for further batches. Callers discover it with dynamic_cast
+    // and fall back to a fresh AbstractGameManager per run otherwise.
+
+    class BatchGameManager
+    {
+    public:
+        virtual ~BatchGameManager() = default;
+
+        // called once per game, in the order of `games`, as soon as that game is over; the
+        // game manager's per-game queries (e.g. BudgetedGameManager) already cover it
+        using GameFinished = std::function<void(size_t game, GameResult result)>;
+
+        virtual void runBatch(size_t map_width, size_t map_height, std::vector<BatchGame> &games,
+                              const GameFinished &finished) = 0;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace UserCommon_212788293_212497127
+{
+    // ========================= Binary map format =========================
+    // A map stored ready to use: the Simulator maps the file and reads the cells in place,
+    // nothing is parsed. Integers are stored in host byte order.
+    //
+    //   header : magic "TNKM", u16 version, u16 0, u32 width, u32 height, u64 max_steps,
+    //            u64 num_shells, u32 checksum, u32 0                           (40 bytes)
+    //   grid   : (width*height+1)/2 bytes, two cells per byte in row-major order; cell i is
+    //            the low nibble of byte i/2 when i is even, the high nibble when odd.
+    //            An odd cell count leaves the last high nibble 0.
+    //
+    // Cell codes follow the text symbols: 0 ' ', 1 '#', 2 '@', 3 '1', 4 '2'. The checksum
+    // is FNV-1a (32 bit) over the grid bytes.
+    namespace BinaryMap
+    {
+        constexpr char MAGIC[4] = {'T', 'N', 'K', 'M'};
+        constexpr std::uint16_t VERSION = 1;
+        constexpr const char *EXTENSION = ".bin";
+
+        struct Header
+        {
+            char magic[4];
+            std::uint16_t version;
+            std::uint16_t reserved0;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint64_t maxSteps;
+            std::uint64_t numShells;
+            std::uint32_t checksum;
+            std::uint32_t reserved1;
+        };
+        static_assert(sizeof(Header) == 40, "binary map header must stay 40 bytes");
+
+        constexpr char SYMBOLS[5] = {' ', '#', '@', '1', '2'};
+        constexpr std::uint8_t CODE_COUNT = 5;
+        // code of a text symbol, CODE_COUNT for symbols a map cannot hold
+        constexpr std::uint8_t codeOf(char symbol)
+        {
+            for (std::uint8_t code = 0; code < CODE_COUNT; ++code)
+            {
+                if (SYMBOLS[code] == symbol)
+                    return code;
+            }
+            return CODE_COUNT;
+        }
+
+        inline std::size_t gridBytes(std::size_t width, std::size_t height) { return (width * height + 1) / 2; }
+
+        inline std::uint32_t checksum(const std::uint8_t *bytes, std::size_t size)
+        {
+            std::uint32_t h = 2166136261u;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                h ^= bytes[i];
+                h *= 16777619u;
+            }
+            return h;
+        }
+
+        inline char cellAt(const std::uint8_t *grid, std::size_t cell)
+        {
+            const std::uint8_t byte = grid[cell / 2];
+            return SYMBOLS[(cell & 1) ? (byte >> 4) : (byte & 0x0F)];
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include "common/SatelliteView.h"
+
+namespace UserCommon_212788293_212497127
+{
+    // Row-major cells of a whole satellite image, empty when the view has no such storage.
+    // The view shows cell `self` as '%' whatever is stored there; out of range when it has none.
+    struct SatelliteSpan
+    {
+        const char *cells{};
+        size_t width{};
+        size_t height{};
+        size_t self{static_cast<size_t>(-1)};
+
+        bool empty() const { return cells == nullptr; }
+    };
+
+    // ========================= CLASS: BulkSatelliteView =========================
+    // Optional extension of SatelliteView (common/ is fixed): copies whole rows or rectangles
+    // in one call instead of one virtual getObjectAt per cell. Consumers should go through
+    // copySatelliteRegion / copySatelliteRow below, which fall back to getObjectAt for views
+    // that do not implement it (e.g. plugins built before this interface existed).
+
+    class BulkSatelliteView
+    {
+    public:
+        virtual ~BulkSatelliteView() = default;
+
+        // writes the w x h rectangle at (x, y) to out, `stride` chars between rows;
+        // the rectangle is inside the view
+        virtual void copyRegion(size_t x, size_t y, size_t w, size_t h, char *out, size_t stride) const = 0;
+
+        // the view's own storage, to be read in place instead of copied
+        virtual SatelliteSpan span() const { return {}; }
+    };
+
+    // the view's storage, empty when it has none or does not implement the extension
+    inline SatelliteSpan satelliteSpan(const SatelliteView &view)
+    {
+        if (const auto *bulk = dynamic_cast<const BulkSatelliteView *>(&view))
+            return bulk->span();
+        return {};
+    }
+
+    inline void copySatelliteRegion(const SatelliteView &view, size_t x, size_t y, size_t w, size_t h,
+                                    char *out, size_t stride)
+    {
+        if (const auto *bulk = dynamic_cast<const BulkSatelliteView *>(&view))
+        {
+            bulk->copyRegion(x, y, w, h, out, stride);
+            return;
+        }
+        for (size_t row = 0; row < h; ++row)
+        {
+            for (size_t col = 0; col < w; ++col)
+                out[row * stride + col] = view.getObjectAt(x + col, y + row);
+        }
+    }
+
+    inline void copySatelliteRow(const SatelliteView &view, size_t y, size_t width, char *out)
+    {
+        copySatelliteRegion(view, 0, y, width, 1, out, width);
+    }
+
+    // copies a whole width x height view to out (width * height chars, row-major)
+    inline void copySatellite(const SatelliteView &view, size_t width, size_t height, char *out)
+    {
+        copySatelliteRegion(view, 0, 0, width, height, out, width);
+    }
+}
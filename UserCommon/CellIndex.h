@@ -0,0 +1,133 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace UserCommon_212788293_212497127
+{
+    // ========================= CLASS: GridIndex =========================
+    // Linear cell index of a width x height grid: index = y * width + x. Indices are dense in
+    // [0, width * height), so per-cell data can live in flat arrays and bitsets.
+
+    class GridIndex
+    {
+    private:
+        int width{};
+        int height{};
+
+    public:
+        constexpr GridIndex() = default;
+        constexpr GridIndex(int width, int height) : width(width), height(height) {}
+
+        constexpr int getWidth() const { return width; }
+        constexpr int getHeight() const { return height; }
+        constexpr int size() const { return width * height; }
+
+        constexpr int index(int x, int y) const { return y * width + x; }
+        constexpr int xOf(int idx) const { return idx % width; }
+        constexpr int yOf(int idx) const { return idx / width; }
+        constexpr std::pair<int, int> position(int idx) const { return {idx % width, idx / width}; }
+    };
+
+    // ========================= CLASS: CellSet =========================
+    // Set of cell indices of one grid, stored as a bitset. Iteration visits the cells in
+    // increasing index order (row by row).
+
+    class CellSet
+    {
+    private:
+        std::vector<std::uint64_t> words;
+        size_t cellCount{};
+
+    public:
+        class const_iterator
+        {
+        private:
+            const std::vector<std::uint64_t> *words{};
+            size_t word{};
+            std::uint64_t bits{};
+
+            void skipEmpty()
+            {
+                while (bits == 0 && ++word < words->size())
+                    bits = (*words)[word];
+            }
+
+        public:
+            const_iterator() = default;
+            const_iterator(const std::vector<std::uint64_t> &words, size_t word)
+                : words(&words), word(word), bits(word < words.size() ? words[word] : 0)
+            {
+                if (word < words.size())
+                    skipEmpty();
+            }
+
+            int operator*() const { return static_cast<int>(word * 64 + std::countr_zero(bits)); }
+            const_iterator &operator++()
+            {
+                bits &= bits - 1;
+                skipEmpty();
+                return *this;
+            }
+            bool operator==(const const_iterator &other) const
+            {
+                return word == other.word && bits == other.bits;
+            }
+        };
+
+        CellSet() = default;
+        explicit CellSet(int cells) { reset(cells); }
+
+        // empties the set and sizes it for cells [0, cells)
+        void reset(int cells)
+        {
+            words.assign((static_cast<size_t>(cells) + 63) / 64, 0);
+            cellCount = 0;
+        }
+
+        void insert(int idx)
+        {
+            std::uint64_t &word = words[static_cast<size_t>(idx) >> 6];
+            const std::uint64_t bit = std::uint64_t{1} << (idx & 63);
+            cellCount += (word & bit) == 0;
+            word |= bit;
+        }
+
+        void erase(int idx)
+        {
+            std::uint64_t &word = words[static_cast<size_t>(idx) >> 6];
+            const std::uint64_t bit = std::uint64_t{1} << (idx & 63);
+            cellCount -= (word & bit) != 0;
+            word &= ~bit;
+        }
+
+        bool contains(int idx) const
+        {
+            const size_t word = static_cast<size_t>(idx) >> 6;
+            return idx >= 0 && word < words.size() && (words[word] >> (idx & 63)) & 1;
+        }
+
+        size_t size() const { return cellCount; }
+        bool empty() const { return cellCount == 0; }
+
+        // adds every cell of `other`, a set of the same grid
+        CellSet &operator|=(const CellSet &other)
+        {
+            cellCount = 0;
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                words[i] |= other.words[i];
+                cellCount += std::popcount(words[i]);
+            }
+            return *this;
+        }
+
+        bool operator==(const CellSet &other) const { return words == other.words; }
+
+        const_iterator begin() const { return const_iterator(words, 0); }
+        const_iterator end() const { return const_iterator(words, words.size()); }
+    };
+}
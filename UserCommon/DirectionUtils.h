@@ -2,7 +2,9 @@
 
 #include <unordered_map>
 #include <array>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <functional>
 #include <set>
@@ -41,22 +43,54 @@ struct pair_hash
     }
 };
 
-Direction &operator+=(Direction &dir, double angle);
-
 // =========================== UTILS =============================
-int bijection(int x, int y);
-std::pair<int, int> inverseBijection(int z);
 std::string to_string(ActionRequest action);
 
+// Compile-time direction tables. Directions are numbered clockwise from U, so every
+// table is indexed by the Direction itself and rotations are arithmetic modulo 8.
 class DirectionsUtils
 {
 public:
-    static std::unordered_map<Direction, std::array<int, 2>> stringToIntDirection;
-    static std::unordered_map<std::string, Direction> stringToDirection;
-    static std::unordered_map<Direction, Direction> reverseDirection;
-    static std::unordered_map<std::string, double> stringToAngle;
-    static std::unordered_map<std::pair<int, int>, Direction, pair_hash> pairToDirections;
-    static std::unordered_map<Direction, std::string> directionToString;
-    static std::array<Direction, 8> directions;
+    static constexpr std::array<Direction, 8> directions = {U, UR, R, DR, D, DL, L, UL};
+
+    // (dx, dy) of one step in a direction
+    static constexpr std::array<std::array<int, 2>, 8> stringToIntDirection = {{
+        {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}}};
+
+    static constexpr std::array<Direction, 8> reverseDirection = {D, DL, L, UL, U, UR, R, DR};
+
+    static constexpr std::array<std::string_view, 8> directionToString = {"U", "UR", "R", "DR", "D", "DL", "L", "UL"};
+
+    // eighths > 0 turns right (clockwise), eighths < 0 turns left
+    static constexpr Direction rotate(Direction dir, int eighths)
+    {
+        return static_cast<Direction>((static_cast<int>(dir) + eighths % 8 + 8) % 8);
+    }
+
+    // number of right 45 degree turns from `from` to `to`, in [0, 8)
+    static constexpr int eighthsBetween(Direction from, Direction to)
+    {
+        return (static_cast<int>(to) - static_cast<int>(from) + 8) % 8;
+    }
+
+    // direction of a step with dx, dy in {-1, 0, 1}; (0, 0) maps to U
+    static constexpr Direction pairToDirection(int dx, int dy)
+    {
+        constexpr std::array<Direction, 9> byOffset = {UL, U, UR, L, U, R, DL, D, DR};
+        return byOffset[(dy + 1) * 3 + (dx + 1)];
+    }
+
+    static constexpr std::optional<Direction> stringToDirection(std::string_view name)
+    {
+        for (Direction dir : directions)
+        {
+            if (directionToString[dir] == name)
+                return dir;
+        }
+        return std::nullopt;
+    }
 };
+
+static_assert(DirectionsUtils::rotate(U, -1) == UL && DirectionsUtils::rotate(UL, 2) == UR);
+static_assert(DirectionsUtils::pairToDirection(1, 1) == DR && DirectionsUtils::pairToDirection(0, 0) == U);
 }
\ No newline at end of file
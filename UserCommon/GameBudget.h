@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace UserCommon_212788293_212497127
+{
+    // Wall-clock limits of one game; zero means unlimited
+    struct GameBudget
+    {
+        // time spent on the game's own setup and rounds
+        std::chrono::milliseconds game{0};
+        // a single TankAlgorithm::getAction or Player::updateTankWithBattleInfo call
+        std::chrono::milliseconds tankCall{0};
+    };
+
+    // Set once by whoever runs the games (e.g. on SIGINT), polled by the game managers
+    // between rounds. cancel() is a lock-free store and may be called from a signal handler.
+    class CancellationToken
+    {
+    public:
+        void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+        bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> cancelled{false};
+    };
+
+    // Why a game was cut short. GameResult::Reason (common/) has no value for it, so such
+    // games report MAX_STEPS there and the cause here.
+    enum class Timeout
+    {
+        None,
+        TankCall,  // a player's call overran the budget, that player loses (both: tie)
+        GameTime,  // the game budget ran out, tie
+        Cancelled  // the token was cancelled, tie
+    };
+
+    inline const char *timeoutName(Timeout timeout)
+    {
+        switch (timeout)
+        {
+        case Timeout::TankCall:
+            return "TANK_CALL_TIMEOUT";
+        case Timeout::GameTime:
+            return "GAME_TIMEOUT";
+        case Timeout::Cancelled:
+            return "CANCELLED";
+        default:
+            return "NONE";
+        }
+    }
+
+    // ========================= CLASS: BudgetedGameManager =========================
+    // Optional extension of AbstractGameManager: a game manager that enforces a GameBudget
+    // and stops at a cancelled token. The checks are cooperative: calls are timed, not
+    // interrupted, and the game ends at the round boundary after the budget is exceeded.
+    // Found by the Simulator with dynamic_cast.
+
+    class BudgetedGameManager
+    {
+    public:
+        virtual ~BudgetedGameManager() = default;
+
+        // applies to every game started afterwards; a null token is never cancelled
+        virtual void setBudget(const GameBudget &budget, std::shared_ptr<const CancellationToken> token) = 0;
+
+        // how game `game` of the last runBatch ended (0 after run)
+        virtual Timeout getTimeout(size_t game) const = 0;
+
+        // time game `game` of the last runBatch spent in its own setup and rounds, the time
+        // charged against GameBudget::game (0 after run)
+        virtual std::chrono::duration<double> getPlayTime(size_t game) const = 0;
+    };
+}
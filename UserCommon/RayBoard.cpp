@@ -0,0 +1,203 @@
+#include "RayBoard.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+
+namespace UserCommon_212788293_212497127
+{
+    // ------------------------ RayBoard ------------------------
+
+    std::shared_ptr<const RayBoard::Geometry> RayBoard::geometryFor(int width, int height)
+    {
+        // boards of one game all have the same size, so remembering the last one is enough
+        thread_local std::shared_ptr<const Geometry> last;
+        if (last && last->width == width && last->height == height)
+            return last;
+
+        auto geometry = std::make_shared<Geometry>();
+        geometry->width = width;
+        geometry->height = height;
+        const int lines = std::gcd(width, height);
+        geometry->diagonalLength = width / lines * height;
+        geometry->diagonalSlot.assign(static_cast<size_t>(width) * height, 0);
+        geometry->antiDiagonalSlot.assign(static_cast<size_t>(width) * height, 0);
+
+        // diagonal k starts at (k, 0); stepping (1, 1) or (1, -1) visits every cell of it
+        for (int k = 0; k < lines; ++k)
+        {
+            int x = k, down = 0, up = 0;
+            for (int t = 0; t < geometry->diagonalLength; ++t)
+            {
+                const int slot = k * geometry->diagonalLength + t;
+                geometry->diagonalSlot[static_cast<size_t>(down) * width + x] = slot;
+                geometry->antiDiagonalSlot[static_cast<size_t>(up) * width + x] = slot;
+                x = x + 1 == width ? 0 : x + 1;
+                down = down + 1 == height ? 0 : down + 1;
+                up = up == 0 ? height - 1 : up - 1;
+            }
+        }
+
+        last = std::move(geometry);
+        return last;
+    }
+
+    void RayBoard::reset(int width, int height)
+    {
+        grid = GridIndex(width, height);
+        geometry = geometryFor(width, height);
+        const size_t words = (static_cast<size_t>(grid.size()) + 63) / 64;
+        for (auto &layer : planes)
+            for (auto &plane : layer)
+                plane.words.assign(words, 0);
+    }
+
+    int RayBoard::slot(Orientation orientation, int x, int y) const
+    {
+        switch (orientation)
+        {
+        case Rows:
+            return y * grid.getWidth() + x;
+        case Columns:
+            return x * grid.getHeight() + y;
+        case Diagonals:
+            return geometry->diagonalSlot[grid.index(x, y)];
+        default:
+            return geometry->antiDiagonalSlot[grid.index(x, y)];
+        }
+    }
+
+    int RayBoard::lineLength(Orientation orientation) const
+    {
+        switch (orientation)
+        {
+        case Rows:
+            return grid.getWidth();
+        case Columns:
+            return grid.getHeight();
+        default:
+            return geometry->diagonalLength;
+        }
+    }
+
+    void RayBoard::set(Layer layer, int x, int y)
+    {
+        for (int o = 0; o < ORIENTATION_COUNT; ++o)
+            planes[layer][o].set(slot(static_cast<Orientation>(o), x, y));
+    }
+
+    void RayBoard::clear(Layer layer, int x, int y)
+    {
+        for (int o = 0; o < ORIENTATION_COUNT; ++o)
+            planes[layer][o].clear(slot(static_cast<Orientation>(o), x, y));
+    }
+
+    void RayBoard::assign(Layer layer, const CellSet &cells)
+    {
+        for (auto &plane : planes[layer])
+            std::fill(plane.words.begin(), plane.words.end(), 0);
+        for (int cell : cells)
+            set(layer, grid.xOf(cell), grid.yOf(cell));
+    }
+
+    bool RayBoard::test(Layer layer, int x, int y) const
+    {
+        return planes[layer][Rows].test(slot(Rows, x, y));
+    }
+
+    int RayBoard::Plane::findNext(int begin, int end) const
+    {
+        if (begin >= end)
+            return -1;
+        size_t word = static_cast<size_t>(begin) >> 6;
+        const size_t lastWord = static_cast<size_t>(end - 1) >> 6;
+        std::uint64_t bits = words[word] & (~std::uint64_t{0} << (begin & 63));
+        while (bits == 0)
+        {
+            if (++word > lastWord)
+                return -1;
+            bits = words[word];
+        }
+        const int bit = static_cast<int>(word * 64) + std::countr_zero(bits);
+        return bit < end ? bit : -1;
+    }
+
+    int RayBoard::Plane::findPrev(int begin, int end) const
+    {
+        if (begin >= end)
+            return -1;
+        const size_t firstWord = static_cast<size_t>(begin) >> 6;
+        size_t word = static_cast<size_t>(end - 1) >> 6;
+        std::uint64_t bits = words[word] & (~std::uint64_t{0} >> (63 - ((end - 1) & 63)));
+        while (bits == 0)
+        {
+            if (word-- == firstWord)
+                return -1;
+            bits = words[word];
+        }
+        const int bit = static_cast<int>(word * 64) + 63 - std::countl_zero(bits);
+        return bit >= begin ? bit : -1;
+    }
+
+    int RayBoard::firstHit(Layer layer, int x, int y, Direction dir, int maxSteps) const
+    {
+        // U/D run along columns, L/R along rows, UL/DR along diagonals and DL/UR along
+        // anti-diagonals; the directions UR through D walk their line forwards
+        static constexpr std::array<Orientation, 8> orientationOf = {
+            Columns, AntiDiagonals, Rows, Diagonals, Columns, AntiDiagonals, Rows, Diagonals};
+        const Orientation orientation = orientationOf[dir];
+        const bool forward = dir >= UR && dir <= D;
+
+        const int length = lineLength(orientation);
+        const int steps = std::min(maxSteps, length);
+        if (steps <= 0 || x < 0 || y < 0 || x >= grid.getWidth() || y >= grid.getHeight())
+            return 0;
+
+        const Plane &plane = planes[layer][orientation];
+        const int at = slot(orientation, x, y);
+        const int pos = at % length;
+        const int base = at - pos;
+
+        if (forward)
+        {
+            // positions pos + 1 .. pos + steps, wrapping to the start of the line
+            int hit = plane.findNext(at + 1, base + std::min(pos + steps, length - 1) + 1);
+            if (hit >= 0)
+                return hit - at;
+            if (pos + steps >= length)
+            {
+                hit = plane.findNext(base, base + pos + steps - length + 1);
+                if (hit >= 0)
+                    return hit - base + length - pos;
+            }
+            return 0;
+        }
+
+        // positions pos - 1 .. pos - steps, wrapping to the end of the line
+        int hit = plane.findPrev(base + std::max(pos - steps, 0), at);
+        if (hit >= 0)
+            return at - hit;
+        if (pos - steps < 0)
+        {
+            hit = plane.findPrev(base + length + pos - steps, base + length);
+            if (hit >= 0)
+                return pos + length - (hit - base);
+        }
+        return 0;
+    }
+
+    int RayBoard::firstHit(unsigned layers, int x, int y, Direction dir, int maxSteps) const
+    {
+        int nearest = 0;
+        for (int layer = 0; layer < LAYER_COUNT; ++layer)
+        {
+            if ((layers & layerBit(static_cast<Layer>(layer))) == 0)
+                continue;
+            const int hit = firstHit(static_cast<Layer>(layer), x, y, dir, nearest ? nearest : maxSteps);
+            if (hit && (!nearest || hit < nearest))
+                nearest = hit;
+        }
+        return nearest;
+    }
+}
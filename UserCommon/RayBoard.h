@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CellIndex.h"
+#include "DirectionUtils.h"
+
+namespace UserCommon_212788293_212497127
+{
+    // ========================= CLASS: RayBoard =========================
+    // Bitboards for line-of-sight queries on the toroidal map. Every layer is kept in four
+    // orientations: rows, columns, diagonals (dx == dy) and anti-diagonals (dx == -dy). Each
+    // orientation packs its lines one after another, so a ray is a cyclic bit range of one
+    // line and "first blocker along a direction" is a word-level scan instead of a walk
+    // over cells. On a W x H torus a diagonal closes after lcm(W, H) cells, so there are
+    // gcd(W, H) diagonals of that length.
+
+    class RayBoard
+    {
+    public:
+        enum Layer
+        {
+            Walls,
+            Mines,
+            Friendly,
+            Enemy,
+            Shells,
+            LAYER_COUNT
+        };
+
+        static constexpr unsigned layerBit(Layer layer) { return 1u << layer; }
+
+        RayBoard() = default;
+        RayBoard(int width, int height) { reset(width, height); }
+
+        // empties every layer; the line tables are shared between boards of the same size
+        void reset(int width, int height);
+
+        const GridIndex &getGrid() const { return grid; }
+
+        void set(Layer layer, int x, int y);
+        void clear(Layer layer, int x, int y);
+        void assign(Layer layer, const CellSet &cells);
+        bool test(Layer layer, int x, int y) const;
+
+        // steps (1..maxSteps) from (x, y) along dir to the first cell that is in `layer`,
+        // or 0 when there is none or (x, y) is off the board. The ray wraps around the board;
+        // a ray longer than its line comes back to (x, y) itself after one line length.
+        int firstHit(Layer layer, int x, int y, Direction dir, int maxSteps) const;
+
+        // nearest hit over several layers, given as a mask of layerBit values
+        int firstHit(unsigned layers, int x, int y, Direction dir, int maxSteps) const;
+
+    private:
+        // where every cell sits in the packed lines of each orientation
+        struct Geometry
+        {
+            int width{};
+            int height{};
+            int diagonalLength{};
+            std::vector<std::int32_t> diagonalSlot;
+            std::vector<std::int32_t> antiDiagonalSlot;
+        };
+
+        enum Orientation
+        {
+            Rows,
+            Columns,
+            Diagonals,
+            AntiDiagonals,
+            ORIENTATION_COUNT
+        };
+
+        // one orientation of one layer: lines of `length` bits packed back to back
+        struct Plane
+        {
+            std::vector<std::uint64_t> words;
+
+            void set(int bit) { words[static_cast<size_t>(bit) >> 6] |= std::uint64_t{1} << (bit & 63); }
+            void clear(int bit) { words[static_cast<size_t>(bit) >> 6] &= ~(std::uint64_t{1} << (bit & 63)); }
+            bool test(int bit) const { return (words[static_cast<size_t>(bit) >> 6] >> (bit & 63)) & 1; }
+
+            // first / last set bit in [begin, end), or -1
+            int findNext(int begin, int end) const;
+            int findPrev(int begin, int end) const;
+        };
+
+        static std::shared_ptr<const Geometry> geometryFor(int width, int height);
+
+        // slot of (x, y) in the given orientation
+        int slot(Orientation orientation, int x, int y) const;
+        int lineLength(Orientation orientation) const;
+
+        GridIndex grid;
+        std::shared_ptr<const Geometry> geometry;
+        std::array<std::array<Plane, ORIENTATION_COUNT>, LAYER_COUNT> planes;
+    };
+}
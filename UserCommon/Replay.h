@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace UserCommon_212788293_212497127
+{
+    // ========================= Binary replay format =========================
+    // A replay file is written by the GameManager and rendered back to the text
+    // moves/visualization files by the ReplayTool. Integers are stored in host byte order,
+    // strings as a u16 length followed by the bytes.
+    //
+    //   header : magic "TNKR", u16 version, u16 width, u16 height, u32 max_steps,
+    //            u32 num_shells, u16 tank count, u16 keyframe interval,
+    //            str game manager, str map name, str player 1 name, str player 2 name,
+    //            width*height chars of the map at round 0 (visualization symbols)
+    //   step   : u8 'S', u32 step, per tank {u8 requested action, u8 outcome},
+    //            u8 'K' + width*height chars (keyframe)
+    //            or u8 'D' + u32 count + count * {u32 cell, u8 char} (delta to the previous frame)
+    //   end    : u8 'E', i32 winner, u8 reason, u32 rounds, u32 tanks left (player 1), u32 (player 2)
+    //
+    // The game has no random source, so a replay needs no seed: the requested actions of
+    // every round determine the whole game.
+    namespace Replay
+    {
+        constexpr char MAGIC[4] = {'T', 'N', 'K', 'R'};
+        constexpr std::uint16_t VERSION = 1;
+        constexpr std::uint16_t KEYFRAME_INTERVAL = 32;
+
+        constexpr std::uint8_t STEP_RECORD = 'S';
+        constexpr std::uint8_t END_RECORD = 'E';
+        constexpr std::uint8_t KEY_FRAME = 'K';
+        constexpr std::uint8_t DELTA_FRAME = 'D';
+
+        // requested action of a tank that is no longer in the game
+        constexpr std::uint8_t NO_ACTION = 0xFF;
+
+        // outcome byte: low nibble is the ActionRequest reported in the moves file
+        constexpr std::uint8_t ACTION_MASK = 0x0F;
+        constexpr std::uint8_t RECORDED = 1 << 4; // the tank reported a move at least once
+        constexpr std::uint8_t IGNORED = 1 << 5;
+        constexpr std::uint8_t KILLED = 1 << 6; // killed during this step
+        constexpr std::uint8_t DEAD = 1 << 7;   // killed in an earlier step
+    }
+
+    // ========================= CLASS: ReplayRecorder =========================
+    // Optional extension of AbstractGameManager: a game manager that records a binary replay
+    // of every game it plays into the given directory. Found by the Simulator with dynamic_cast.
+
+    class ReplayRecorder
+    {
+    public:
+        virtual ~ReplayRecorder() = default;
+        virtual void setReplayDirectory(const std::string &dir) = 0;
+    };
+}
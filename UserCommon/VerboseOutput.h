@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+namespace UserCommon_212788293_212497127
+{
+    // What writing the verbose files has cost so far
+    struct VerboseOutputStats
+    {
+        std::uint64_t bytesWritten{};
+        std::uint64_t writeCalls{};
+        std::uint64_t producerStalls{};    // writes that found the output buffer full
+        std::uint64_t stallMicroseconds{}; // time games spent waiting for room in it
+
+        VerboseOutputStats &operator+=(const VerboseOutputStats &other)
+        {
+            bytesWritten += other.bytesWritten;
+            writeCalls += other.writeCalls;
+            producerStalls += other.producerStalls;
+            stallMicroseconds += other.stallMicroseconds;
+            return *this;
+        }
+    };
+
+    // ========================= CLASS: VerboseOutputReporter =========================
+    // Optional extension of AbstractGameManager: a game manager that accounts for the verbose
+    // output it writes. Found by the Simulator with dynamic_cast, which reports the totals once
+    // all games are over.
+
+    class VerboseOutputReporter
+    {
+    public:
+        virtual ~VerboseOutputReporter() = default;
+        // totals of every game manager of the plugin so far, not only of this one
+        virtual VerboseOutputStats getVerboseOutputStats() const = 0;
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace UserCommon_212788293_212497127
+{
+    // How the rounds of a verbose visualization file are written:
+    //   Full  : every round is the whole map, one text row per map row
+    //   Delta : round 1 and every Replay::KEYFRAME_INTERVAL-th round are full, the others
+    //           only list the cells that changed, one "x y symbol" line per cell:
+    //
+    //           === Game Step 7 (delta) ===
+    //           3 4 *
+    //           3 5 .
+    enum class FrameFormat
+    {
+        Full,
+        Delta
+    };
+
+    // ========================= CLASS: FrameFormatSelector =========================
+    // Optional extension of AbstractGameManager: a game manager whose verbose visualization
+    // can be written as delta frames. Found by the Simulator with dynamic_cast.
+
+    class FrameFormatSelector
+    {
+    public:
+        virtual ~FrameFormatSelector() = default;
+        virtual void setFrameFormat(FrameFormat format) = 0;
+    };
+}